@@ -0,0 +1,186 @@
+#include "ads1299.h"
+#include "hardware/spi.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+// Comandos e registradores usados (datasheet ADS1299, seção 9.5)
+#define CMD_START   0x08
+#define CMD_RDATAC  0x10
+#define CMD_SDATAC  0x11
+#define CMD_WREG    0x40
+#define REG_CONFIG1 0x01
+#define REG_CONFIG3 0x03
+#define REG_CH1SET  0x05
+
+// CONFIG1: bits reservados 1001 0 + taxa (DR)
+#if ADS1299_TAXA_HZ == 250
+#define CONFIG1_DR 0x06
+#elif ADS1299_TAXA_HZ == 500
+#define CONFIG1_DR 0x05
+#elif ADS1299_TAXA_HZ == 1000
+#define CONFIG1_DR 0x04
+#else
+#error "ADS1299_TAXA_HZ deve ser 250, 500 ou 1000"
+#endif
+#define CONFIG1_VALOR (0x90 | CONFIG1_DR)
+#define CONFIG3_VALOR 0xE0          // Referência interna ligada
+#define CHSET_VALOR 0x60            // Ganho 24, entrada normal
+
+// 3 bytes de status + 3 bytes por canal, MSB primeiro, complemento de 2
+#define BYTES_QUADRO (3 + 3 * ADS1299_NUM_CANAIS)
+
+static uint8_t quadro_rx[BYTES_QUADRO];
+static const uint8_t zero = 0;
+
+// Quadros prontos para o consumidor
+static QuadroAmostras quadros[FONTE_CAPACIDADE_ANEL];
+static AnelQuadros anel;
+
+static uint canal_tx;
+static uint canal_rx;
+static uint64_t instante_drdy_us;
+static volatile uint32_t quadros_perdidos = 0;
+
+static inline void selecionar(bool ativo) {
+    gpio_put(ADS1299_PINO_CS, !ativo);
+}
+
+static void enviar(const uint8_t *bytes, size_t num) {
+    selecionar(true);
+    spi_write_blocking(ADS1299_SPI, bytes, num);
+    sleep_us(2);    // tSDECODE + tCSH
+    selecionar(false);
+    sleep_us(2);
+}
+
+static void enviar_comando(uint8_t comando) {
+    enviar(&comando, 1);
+}
+
+static void escrever_registradores(uint8_t inicio, const uint8_t *valores, uint8_t num) {
+    uint8_t buf[2 + ADS1299_NUM_CANAIS];
+    buf[0] = CMD_WREG | inicio;
+    buf[1] = num - 1;
+    for (uint8_t i = 0; i < num; i++) buf[2 + i] = valores[i];
+    enviar(buf, 2u + num);
+}
+
+// Borda de descida do DRDY: dispara a leitura do quadro. Se a anterior ainda
+// não terminou (SPI lento demais para a taxa), o quadro é perdido.
+static void ads1299_drdy_isr(void) {
+    if (!(gpio_get_irq_event_mask(ADS1299_PINO_DRDY) & GPIO_IRQ_EDGE_FALL)) return;
+    gpio_acknowledge_irq(ADS1299_PINO_DRDY, GPIO_IRQ_EDGE_FALL);
+
+    if (dma_channel_is_busy(canal_rx)) {
+        quadros_perdidos++;
+        return;
+    }
+
+    instante_drdy_us = time_us_64();
+    selecionar(true);
+    dma_channel_set_write_addr(canal_rx, quadro_rx, false);
+    dma_channel_set_trans_count(canal_rx, BYTES_QUADRO, false);
+    dma_channel_set_read_addr(canal_tx, &zero, false);
+    dma_channel_set_trans_count(canal_tx, BYTES_QUADRO, false);
+    dma_start_channel_mask((1u << canal_tx) | (1u << canal_rx));
+}
+
+// Fim da leitura: libera o barramento e publica o quadro com os canais de
+// 24 bits convertidos, carimbado com o instante do DRDY
+static void ads1299_dma_isr(void) {
+    if (!dma_channel_get_irq1_status(canal_rx)) return;
+    dma_channel_acknowledge_irq1(canal_rx);
+    selecionar(false);
+
+    QuadroAmostras *q = anel_reservar(&anel);
+    if (!q) return;
+    q->instante_us = instante_drdy_us;
+
+    const uint8_t *p = &quadro_rx[3];
+    for (uint c = 0; c < ADS1299_NUM_CANAIS; c++, p += 3) {
+        uint32_t v = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8);
+        q->canais[c] = (int32_t)v >> 8;     // Extensão de sinal
+    }
+    anel_publicar(&anel);
+}
+
+void ads1299_init(void) {
+    anel_init(&anel, quadros, FONTE_CAPACIDADE_ANEL);
+
+    spi_init(ADS1299_SPI, ADS1299_SPI_HZ);
+    spi_set_format(ADS1299_SPI, 8, SPI_CPOL_0, SPI_CPHA_1, SPI_MSB_FIRST);
+    gpio_set_function(ADS1299_PINO_MISO, GPIO_FUNC_SPI);
+    gpio_set_function(ADS1299_PINO_SCK, GPIO_FUNC_SPI);
+    gpio_set_function(ADS1299_PINO_MOSI, GPIO_FUNC_SPI);
+
+    gpio_init(ADS1299_PINO_CS);
+    gpio_set_dir(ADS1299_PINO_CS, GPIO_OUT);
+    selecionar(false);
+
+    gpio_init(ADS1299_PINO_DRDY);
+    gpio_set_dir(ADS1299_PINO_DRDY, GPIO_IN);
+    gpio_pull_up(ADS1299_PINO_DRDY);
+
+    // Aguarda o power-on reset e configura com a leitura contínua parada
+    sleep_ms(150);
+    enviar_comando(CMD_SDATAC);
+
+    uint8_t config1 = CONFIG1_VALOR;
+    uint8_t config3 = CONFIG3_VALOR;
+    escrever_registradores(REG_CONFIG3, &config3, 1);
+    sleep_ms(10);   // Estabilização da referência interna
+    escrever_registradores(REG_CONFIG1, &config1, 1);
+
+    uint8_t chset[ADS1299_NUM_CANAIS];
+    for (uint c = 0; c < ADS1299_NUM_CANAIS; c++) chset[c] = CHSET_VALOR;
+    escrever_registradores(REG_CH1SET, chset, ADS1299_NUM_CANAIS);
+
+    // TX envia zeros (NOP) enquanto RX recolhe o quadro; só o RX interrompe
+    canal_tx = dma_claim_unused_channel(true);
+    canal_rx = dma_claim_unused_channel(true);
+
+    dma_channel_config ctx = dma_channel_get_default_config(canal_tx);
+    channel_config_set_transfer_data_size(&ctx, DMA_SIZE_8);
+    channel_config_set_read_increment(&ctx, false);
+    channel_config_set_write_increment(&ctx, false);
+    channel_config_set_dreq(&ctx, spi_get_dreq(ADS1299_SPI, true));
+    dma_channel_configure(canal_tx, &ctx, &spi_get_hw(ADS1299_SPI)->dr, &zero, BYTES_QUADRO, false);
+
+    dma_channel_config crx = dma_channel_get_default_config(canal_rx);
+    channel_config_set_transfer_data_size(&crx, DMA_SIZE_8);
+    channel_config_set_read_increment(&crx, false);
+    channel_config_set_write_increment(&crx, true);
+    channel_config_set_dreq(&crx, spi_get_dreq(ADS1299_SPI, false));
+    dma_channel_configure(canal_rx, &crx, quadro_rx, &spi_get_hw(ADS1299_SPI)->dr, BYTES_QUADRO, false);
+
+    dma_channel_set_irq1_enabled(canal_rx, true);
+    irq_add_shared_handler(DMA_IRQ_1, ads1299_dma_isr, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    // Handler próprio do pino: não interfere no callback dos botões
+    gpio_add_raw_irq_handler(ADS1299_PINO_DRDY, ads1299_drdy_isr);
+    gpio_set_irq_enabled(ADS1299_PINO_DRDY, GPIO_IRQ_EDGE_FALL, true);
+
+    enviar_comando(CMD_START);
+    enviar_comando(CMD_RDATAC);
+}
+
+uint32_t ads1299_quadros_perdidos(void) {
+    return quadros_perdidos;
+}
+
+static const FonteCanais fonte = {
+    .nome = "ADS1299",
+    .num_canais = ADS1299_NUM_CANAIS,
+    .taxa_hz = ADS1299_TAXA_HZ,
+    .minimo = -(1 << 23),
+    .maximo = (1 << 23) - 1,
+    .anel = &anel,
+    .iniciar = ads1299_init,
+    .produzir = NULL,
+    .definir_calibracao = NULL,
+};
+
+const FonteCanais *ads1299_fonte(void) {
+    return &fonte;
+}
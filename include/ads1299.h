@@ -0,0 +1,26 @@
+#ifndef ADS1299_H
+#define ADS1299_H
+
+#include "pico/stdlib.h"
+#include "fonte.h"
+
+// Front-end de biopotenciais ADS1299 (ou ADS1299-4/-6) no SPI0. A cada
+// DRDY, um disparo de DMA lê o quadro inteiro (status + todos os canais) e o
+// ISR de fim de transferência o converte e publica no anel da fonte.
+#define ADS1299_NUM_CANAIS 8        // 4, 6 ou 8 conforme a variante
+#define ADS1299_TAXA_HZ 250         // 250, 500 ou 1000 SPS
+
+#define ADS1299_SPI spi0
+#define ADS1299_SPI_HZ 4000000      // Quadro de 27 bytes em ~54 us
+#define ADS1299_PINO_MISO 16
+#define ADS1299_PINO_CS 17
+#define ADS1299_PINO_SCK 18
+#define ADS1299_PINO_MOSI 19
+#define ADS1299_PINO_DRDY 20
+
+void ads1299_init(void);
+uint32_t ads1299_quadros_perdidos(void);
+
+const FonteCanais *ads1299_fonte(void);
+
+#endif
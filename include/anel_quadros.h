@@ -0,0 +1,85 @@
+#ifndef ANEL_QUADROS_H
+#define ANEL_QUADROS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Anel sem trava de um produtor (ISR ou DMA da fonte) e um consumidor (loop
+// principal) com quadros multicanal carimbados no tempo. Capacidade em
+// potência de 2; cada índice só é escrito por um dos lados e as leituras e
+// escritas de 32 bits são atômicas no M0+, então basta uma barreira de
+// memória entre os dados e a publicação do índice. Com o anel cheio o
+// produtor descarta o quadro novo e conta o estouro.
+#define ANEL_MAX_CANAIS 8
+
+typedef struct {
+    uint64_t instante_us;               // Instante da amostragem
+    int32_t canais[ANEL_MAX_CANAIS];
+} QuadroAmostras;
+
+// Passo, em int32_t, entre amostras do mesmo canal em quadros seguidos
+#define QUADRO_PASSO (sizeof(QuadroAmostras) / sizeof(int32_t))
+
+typedef struct {
+    QuadroAmostras *quadros;
+    uint32_t mascara;
+    volatile uint32_t escrita;      // Só o produtor escreve
+    volatile uint32_t leitura;      // Só o consumidor escreve
+    volatile uint32_t estouros;     // Quadros descartados com o anel cheio
+} AnelQuadros;
+
+#if defined(__arm__)
+#define ANEL_BARREIRA() __asm volatile ("dmb" ::: "memory")
+#else
+#define ANEL_BARREIRA() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+static inline void anel_init(AnelQuadros *a, QuadroAmostras *quadros, uint32_t capacidade) {
+    a->quadros = quadros;
+    a->mascara = capacidade - 1;    // capacidade deve ser potência de 2
+    a->escrita = 0;
+    a->leitura = 0;
+    a->estouros = 0;
+}
+
+// Produtor: posição livre para o próximo quadro, ou NULL se o anel está cheio
+static inline QuadroAmostras *anel_reservar(AnelQuadros *a) {
+    uint32_t escrita = a->escrita;
+    if (escrita - a->leitura > a->mascara) {
+        a->estouros++;
+        return NULL;
+    }
+    return &a->quadros[escrita & a->mascara];
+}
+
+// Produtor: torna visível o quadro preenchido após anel_reservar
+static inline void anel_publicar(AnelQuadros *a) {
+    ANEL_BARREIRA();
+    a->escrita = a->escrita + 1;
+}
+
+static inline uint32_t anel_ocupacao(const AnelQuadros *a) {
+    return a->escrita - a->leitura;
+}
+
+// Consumidor: trecho contíguo de quadros prontos, sem cópia. Retorna quantos
+// (até max) podem ser lidos (e alterados) a partir de *inicio até anel_consumir.
+static inline uint32_t anel_trecho(AnelQuadros *a, QuadroAmostras **inicio, uint32_t max) {
+    uint32_t leitura = a->leitura;
+    uint32_t disponiveis = a->escrita - leitura;
+    ANEL_BARREIRA();
+    uint32_t ate_o_fim = a->mascara + 1 - (leitura & a->mascara);
+    if (disponiveis > ate_o_fim) disponiveis = ate_o_fim;
+    if (disponiveis > max) disponiveis = max;
+    *inicio = &a->quadros[leitura & a->mascara];
+    return disponiveis;
+}
+
+// Consumidor: devolve ao produtor os quadros já processados
+static inline void anel_consumir(AnelQuadros *a, uint32_t num) {
+    ANEL_BARREIRA();
+    a->leitura = a->leitura + num;
+}
+
+#endif
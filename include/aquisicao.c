@@ -0,0 +1,124 @@
+#include "aquisicao.h"
+#include "decimador.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+// Clock do ADC (USB PLL, 48 MHz)
+#define ADC_CLOCK_HZ 48000000u
+
+// Amostras brutas por bloco: cada quadro de saída consome DECIMADOR_FATOR
+// conversões de cada canal. O anel bruto tem dois blocos (buffer duplo).
+#define AMOSTRAS_BRUTAS_BLOCO (AQUISICAO_QUADROS_BLOCO * DECIMADOR_FATOR * AQUISICAO_NUM_CANAIS)
+#define BYTES_ANEL_LOG2 12
+
+#define DIVISOR_ADC (ADC_CLOCK_HZ / (AQUISICAO_TAXA_HZ * DECIMADOR_FATOR * AQUISICAO_NUM_CANAIS) - 1)
+
+#if (1u << BYTES_ANEL_LOG2) != (AMOSTRAS_BRUTAS_BLOCO * 2 * 2)
+#error "O anel bruto deve ter 2^BYTES_ANEL_LOG2 bytes"
+#endif
+#if DIVISOR_ADC > 65535 || DIVISOR_ADC < 95
+#error "AQUISICAO_TAXA_HZ fora da faixa do divisor do ADC"
+#endif
+
+// O DMA escreve em anel: o endereço precisa estar alinhado ao tamanho
+static uint16_t anel_bruto[2][AMOSTRAS_BRUTAS_BLOCO] __attribute__((aligned(1u << BYTES_ANEL_LOG2)));
+
+// Bloco recém-decimado, antes da calibração e da publicação no anel
+static uint16_t decimado[AQUISICAO_QUADROS_BLOCO][AQUISICAO_NUM_CANAIS];
+
+// Quadros prontos para o consumidor
+static QuadroAmostras quadros[FONTE_CAPACIDADE_ANEL];
+static AnelQuadros anel;
+
+static DecimadorCic decimadores[AQUISICAO_NUM_CANAIS];
+
+// Correção aplicada antes da publicação (NULL = amostras brutas)
+static const CalibracaoCanal *volatile calibracoes[AQUISICAO_NUM_CANAIS];
+
+static uint canal_dma;
+static uint64_t inicio_us;
+static const uint32_t periodo_us = 1000000u / AQUISICAO_TAXA_HZ;
+static uint32_t blocos_brutos = 0;
+static uint32_t quadros_produzidos = 0;
+
+// Fim de um bloco bruto: o DMA é rearmado na hora (o endereço de escrita já
+// deu a volta para a outra metade do anel, e a FIFO do ADC cobre a latência),
+// o bloco recém-completado é decimado canal a canal e os quadros calibrados
+// são publicados no anel com o instante de amostragem.
+static void aquisicao_dma_isr(void) {
+    if (!dma_channel_get_irq1_status(canal_dma)) return;
+    dma_channel_acknowledge_irq1(canal_dma);
+    dma_channel_set_trans_count(canal_dma, AMOSTRAS_BRUTAS_BLOCO, true);
+
+    const uint16_t *bruto = anel_bruto[blocos_brutos++ & 1];
+    for (uint c = 0; c < AQUISICAO_NUM_CANAIS; c++) {
+        decimador_processar(&decimadores[c], bruto + c, AMOSTRAS_BRUTAS_BLOCO / AQUISICAO_NUM_CANAIS,
+                            AQUISICAO_NUM_CANAIS, &decimado[0][c], AQUISICAO_NUM_CANAIS);
+    }
+
+    for (uint i = 0; i < AQUISICAO_QUADROS_BLOCO; i++, quadros_produzidos++) {
+        QuadroAmostras *q = anel_reservar(&anel);
+        if (!q) continue;
+        q->instante_us = inicio_us + (uint64_t)quadros_produzidos * periodo_us;
+        for (uint c = 0; c < AQUISICAO_NUM_CANAIS; c++) {
+            const CalibracaoCanal *cal = calibracoes[c];
+            uint16_t v = decimado[i][c];
+            q->canais[c] = cal ? calibracao_aplicar(cal, v) : v;
+        }
+        anel_publicar(&anel);
+    }
+}
+
+void aquisicao_init(void) {
+    anel_init(&anel, quadros, FONTE_CAPACIDADE_ANEL);
+    adc_init();
+    for (uint i = 0; i < AQUISICAO_NUM_CANAIS; i++) {
+        adc_gpio_init(26 + i);
+        decimador_init(&decimadores[i]);
+    }
+
+    // Conversão contínua, alternando entre os canais, no ritmo do divisor
+    adc_select_input(0);
+    adc_set_round_robin((1u << AQUISICAO_NUM_CANAIS) - 1);
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv((float)DIVISOR_ADC);
+
+    canal_dma = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(canal_dma);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, BYTES_ANEL_LOG2);
+    channel_config_set_dreq(&c, DREQ_ADC);
+    dma_channel_configure(canal_dma, &c, anel_bruto, &adc_hw->fifo, AMOSTRAS_BRUTAS_BLOCO, true);
+
+    dma_channel_set_irq1_enabled(canal_dma, true);
+    irq_add_shared_handler(DMA_IRQ_1, aquisicao_dma_isr, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    inicio_us = time_us_64();
+    adc_run(true);
+}
+
+// Passa a corrigir um canal com a tabela dada; NULL volta às amostras brutas
+// (usado durante a captura dos pontos de calibração)
+void aquisicao_definir_calibracao(unsigned canal, const CalibracaoCanal *calibracao) {
+    if (canal < AQUISICAO_NUM_CANAIS) calibracoes[canal] = calibracao;
+}
+
+static const FonteCanais fonte = {
+    .nome = "Potenciometros",
+    .num_canais = AQUISICAO_NUM_CANAIS,
+    .taxa_hz = AQUISICAO_TAXA_HZ,
+    .minimo = 0,
+    .maximo = AQUISICAO_FUNDO_ESCALA,
+    .anel = &anel,
+    .iniciar = aquisicao_init,
+    .produzir = NULL,
+    .definir_calibracao = aquisicao_definir_calibracao,
+};
+
+const FonteCanais *aquisicao_fonte(void) {
+    return &fonte;
+}
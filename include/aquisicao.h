@@ -0,0 +1,26 @@
+#ifndef AQUISICAO_H
+#define AQUISICAO_H
+
+#include "pico/stdlib.h"
+#include "fonte.h"
+
+// Canais amostrados em round-robin (entradas do ADC a partir da 0)
+#define AQUISICAO_NUM_CANAIS 2
+
+// Taxa de saída por canal (Hz), após a decimação. O ADC converte a
+// AQUISICAO_TAXA_HZ * DECIMADOR_FATOR por canal; 250, 500 e 1000 Hz são exatos.
+#define AQUISICAO_TAXA_HZ 500
+
+// Fundo de escala das amostras decimadas (12 bits do ADC + 4 bits)
+#define AQUISICAO_FUNDO_ESCALA 65520u
+
+// Quadros (uma amostra de cada canal) decimados a cada interrupção do DMA
+#define AQUISICAO_QUADROS_BLOCO FONTE_QUADROS_BLOCO
+
+void aquisicao_init(void);
+void aquisicao_definir_calibracao(unsigned canal, const CalibracaoCanal *calibracao);
+
+// Potenciômetros no ADC interno como fonte de canais
+const FonteCanais *aquisicao_fonte(void);
+
+#endif
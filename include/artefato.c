@@ -0,0 +1,84 @@
+#include "artefato.h"
+#include <string.h>
+
+void artefato_init(DetectorArtefato *d, const ConfigArtefato *cfg) {
+    memset(d, 0, sizeof(*d));
+    d->cfg = *cfg;
+}
+
+// Classifica uma amostra; retorna a máscara de TipoArtefato detectados nela
+static inline uint32_t classificar(DetectorArtefato *d, int32_t x) {
+    const ConfigArtefato *cfg = &d->cfg;
+    uint32_t tipos = 0;
+
+    if (x <= cfg->trilho_inferior || x >= cfg->trilho_superior) {
+        tipos |= 1u << ARTEFATO_SATURACAO;
+    }
+
+    if (d->iniciado && cfg->salto_max > 0) {
+        int32_t delta = x - d->anterior;
+        if (delta < 0) delta = -delta;
+        if (delta > cfg->salto_max) tipos |= 1u << ARTEFATO_SALTO;
+    }
+
+    if (cfg->plano_amostras > 0) {
+        int32_t desvio = x - d->referencia_plano;
+        if (desvio < 0) desvio = -desvio;
+        if (d->iniciado && desvio <= cfg->plano_tolerancia) {
+            if (d->contagem_plano < cfg->plano_amostras) d->contagem_plano++;
+        } else {
+            d->referencia_plano = x;
+            d->contagem_plano = 0;
+        }
+        if (d->contagem_plano >= cfg->plano_amostras) tipos |= 1u << ARTEFATO_PLANO;
+    }
+
+    d->anterior = x;
+    d->iniciado = true;
+    return tipos;
+}
+
+// Processa um bloco de um canal (passo em elementos), substituindo no lugar
+// as amostras marcadas pela última válida. Retorna quantas foram marcadas.
+uint32_t artefato_processar_bloco(DetectorArtefato *d, int32_t *amostras, uint32_t num, uint32_t passo) {
+    if (!d->iniciado && num > 0) d->ultimo_valido = amostras[0];
+
+    uint32_t marcadas = 0;
+    for (uint32_t n = 0; n < num; n++, amostras += passo) {
+        int32_t x = *amostras;
+        uint32_t tipos = classificar(d, x);
+
+        if (tipos) {
+            for (int t = 0; t < ARTEFATO_NUM_TIPOS; t++) {
+                if (tipos & (1u << t)) d->por_tipo[t]++;
+            }
+            d->guarda_restante = d->cfg.guarda;
+        } else if (d->guarda_restante > 0) {
+            d->guarda_restante--;
+            tipos = 1;   // Ainda dentro da guarda
+        }
+
+        if (tipos) {
+            *amostras = d->ultimo_valido;
+            marcadas++;
+        } else {
+            d->ultimo_valido = x;
+        }
+    }
+
+    d->amostras += num;
+    d->marcadas += marcadas;
+    return marcadas;
+}
+
+// Fração de amostras marcadas, em milésimos
+uint32_t artefato_taxa_milesimos(const DetectorArtefato *d) {
+    if (d->amostras == 0) return 0;
+    return (uint32_t)(((uint64_t)d->marcadas * 1000) / d->amostras);
+}
+
+void artefato_zerar_contagem(DetectorArtefato *d) {
+    d->amostras = 0;
+    d->marcadas = 0;
+    memset(d->por_tipo, 0, sizeof(d->por_tipo));
+}
@@ -0,0 +1,48 @@
+#ifndef ARTEFATO_H
+#define ARTEFATO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Detector de artefatos por canal, amostra a amostra e em O(1): saturação
+// nos trilhos, saltos maiores que o permitido entre amostras e sinal plano
+// (eletrodo solto, ADC travado). Amostras marcadas são substituídas pela
+// última amostra válida antes da filtragem, e a marcação se estende por
+// algumas amostras de guarda depois do artefato.
+typedef enum {
+    ARTEFATO_SATURACAO = 0,
+    ARTEFATO_SALTO,
+    ARTEFATO_PLANO,
+    ARTEFATO_NUM_TIPOS
+} TipoArtefato;
+
+typedef struct {
+    int32_t trilho_inferior;    // Amostras <= inferior ou >= superior estão saturadas
+    int32_t trilho_superior;
+    int32_t salto_max;          // Maior diferença aceita entre amostras seguidas (0 = desligado)
+    int32_t plano_tolerancia;   // Variação máxima de um trecho considerado plano
+    uint16_t plano_amostras;    // Amostras planas seguidas para marcar (0 = desligado)
+    uint16_t guarda;            // Amostras marcadas depois do fim do artefato
+} ConfigArtefato;
+
+typedef struct {
+    ConfigArtefato cfg;
+    int32_t anterior;
+    int32_t ultimo_valido;
+    int32_t referencia_plano;
+    uint16_t contagem_plano;
+    uint16_t guarda_restante;
+    bool iniciado;
+
+    // Contagens desde o início (ou desde artefato_zerar_contagem)
+    uint32_t amostras;
+    uint32_t marcadas;
+    uint32_t por_tipo[ARTEFATO_NUM_TIPOS];
+} DetectorArtefato;
+
+void artefato_init(DetectorArtefato *d, const ConfigArtefato *cfg);
+uint32_t artefato_processar_bloco(DetectorArtefato *d, int32_t *amostras, uint32_t num, uint32_t passo);
+uint32_t artefato_taxa_milesimos(const DetectorArtefato *d);
+void artefato_zerar_contagem(DetectorArtefato *d);
+
+#endif
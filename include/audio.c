@@ -0,0 +1,119 @@
+#include "audio.h"
+#include "audio_pcm.h"
+#include "sonificacao.h"
+#include "pico/util/queue.h"
+#include "hardware/sync.h"
+
+// Deslocamento aplicado ao tom de feedback enquanto um alerta toca
+#define ATENUACAO_FEEDBACK 3
+
+// Margem para a sonificação reassumir o buzzer após um som (ms)
+#define MARGEM_RETOMADA_MS 20
+
+typedef struct {
+    const SomPcm *som;
+    uint8_t prioridade;
+    uint8_t voz;          // Voz preferida
+} DefinicaoSom;
+
+static const DefinicaoSom definicoes[AUDIO_NUM_SONS] = {
+    [AUDIO_SOM_BIPE]          = {&SOM_BIPE,          AUDIO_PRIO_UI,      AUDIO_VOZ_ALERTA},
+    [AUDIO_SOM_SUCESSO]       = {&SOM_SUCESSO,       AUDIO_PRIO_SUCESSO, AUDIO_VOZ_PRINCIPAL},
+    [AUDIO_SOM_ERRO]          = {&SOM_ERRO,          AUDIO_PRIO_ALERTA,  AUDIO_VOZ_ALERTA},
+    [AUDIO_SOM_INICIALIZACAO] = {&SOM_INICIALIZACAO, AUDIO_PRIO_SUCESSO, AUDIO_VOZ_PRINCIPAL},
+};
+
+static queue_t fila;
+static struct repeating_timer timer;
+static volatile uint32_t descartados = 0;
+
+// Prioridade do som que ocupa cada voz (válida enquanto a voz toca)
+static uint8_t prioridade_voz[AUDIO_NUM_VOZES];
+
+// Prioridade do que está na voz agora, ou -1 se livre
+static int prioridade_ocupante(uint voz) {
+    if (audio_pcm_tocando(voz)) return prioridade_voz[voz];
+    if (voz == AUDIO_VOZ_PRINCIPAL && sonificacao_ativa()) return AUDIO_PRIO_FEEDBACK;
+    return -1;
+}
+
+// Escolhe a voz (preferida ou a outra) e preempta ocupantes de prioridade
+// menor ou igual; se ambas estão com sons mais importantes, o pedido é descartado.
+static void despachar(AudioSom id) {
+    const DefinicaoSom *d = &definicoes[id];
+    uint voz = d->voz;
+
+    if (prioridade_ocupante(voz) > d->prioridade) {
+        voz = (voz == AUDIO_VOZ_PRINCIPAL) ? AUDIO_VOZ_ALERTA : AUDIO_VOZ_PRINCIPAL;
+        if (prioridade_ocupante(voz) > d->prioridade) {
+            descartados++;
+            return;
+        }
+    }
+
+    // O tom de feedback cede o buzzer principal e volta sozinho ao final
+    if (voz == AUDIO_VOZ_PRINCIPAL && sonificacao_ativa()) {
+        sonificacao_suspender(audio_pcm_duracao_ms(d->som) + MARGEM_RETOMADA_MS);
+    }
+
+    audio_pcm_tocar(voz, d->som);
+    prioridade_voz[voz] = d->prioridade;
+}
+
+// Despacho periódico: esvazia a fila e aplica o ducking do feedback
+static bool audio_tick(struct repeating_timer *t) {
+    uint8_t id;
+    while (queue_try_remove(&fila, &id)) {
+        despachar((AudioSom)id);
+    }
+
+    bool alerta = audio_pcm_tocando(AUDIO_VOZ_ALERTA) &&
+                  prioridade_voz[AUDIO_VOZ_ALERTA] >= AUDIO_PRIO_SUCESSO;
+    sonificacao_atenuar(alerta ? ATENUACAO_FEEDBACK : 0);
+    return true;
+}
+
+void audio_init(uint gpio_principal, uint gpio_alerta) {
+    sonificacao_init(gpio_principal);
+    audio_pcm_init(gpio_principal, gpio_alerta);
+
+    queue_init(&fila, sizeof(uint8_t), AUDIO_FILA_TAMANHO);
+    add_repeating_timer_us(-(int64_t)(1000000 / AUDIO_TICK_HZ), audio_tick, NULL, &timer);
+}
+
+// Enfileira um pedido sem bloquear; seguro para uso em ISRs
+bool audio_solicitar(AudioSom som) {
+    if (som >= AUDIO_NUM_SONS) return false;
+    uint8_t id = (uint8_t)som;
+    if (!queue_try_add(&fila, &id)) {
+        descartados++;
+        return false;
+    }
+    return true;
+}
+
+uint32_t audio_duracao_ms(AudioSom som) {
+    if (som >= AUDIO_NUM_SONS) return 0;
+    return audio_pcm_duracao_ms(definicoes[som].som);
+}
+
+uint32_t audio_descartados(void) {
+    return descartados;
+}
+
+void audio_feedback_atualizar(q16_t atencao, q16_t relaxamento) {
+    sonificacao_definir_alvo(atencao, relaxamento);
+
+    // Não toma o buzzer de um som em andamento; tenta de novo na próxima chamada
+    uint32_t irq = save_and_disable_interrupts();
+    if (!sonificacao_ativa() && !audio_pcm_tocando(AUDIO_VOZ_PRINCIPAL)) {
+        sonificacao_iniciar();
+    }
+    restore_interrupts(irq);
+}
+
+void audio_feedback_parar(void) {
+    uint32_t irq = save_and_disable_interrupts();
+    sonificacao_parar();
+    restore_interrupts(irq);
+}
@@ -0,0 +1,37 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include "pico/stdlib.h"
+#include "fixo.h"
+
+// Prioridades dos canais lógicos (maior valor preempta menor)
+typedef enum {
+    AUDIO_PRIO_UI = 0,
+    AUDIO_PRIO_FEEDBACK,
+    AUDIO_PRIO_SUCESSO,
+    AUDIO_PRIO_ALERTA
+} AudioPrioridade;
+
+// Sons que podem ser solicitados ao gerenciador
+typedef enum {
+    AUDIO_SOM_BIPE = 0,
+    AUDIO_SOM_SUCESSO,
+    AUDIO_SOM_ERRO,
+    AUDIO_SOM_INICIALIZACAO,
+    AUDIO_NUM_SONS
+} AudioSom;
+
+// Capacidade da fila de pedidos e taxa de despacho
+#define AUDIO_FILA_TAMANHO 8
+#define AUDIO_TICK_HZ 200
+
+void audio_init(uint gpio_principal, uint gpio_alerta);
+bool audio_solicitar(AudioSom som);
+uint32_t audio_duracao_ms(AudioSom som);
+uint32_t audio_descartados(void);
+
+// Canal de feedback contínuo (sonificação) no buzzer principal
+void audio_feedback_atualizar(q16_t atencao, q16_t relaxamento);
+void audio_feedback_parar(void);
+
+#endif
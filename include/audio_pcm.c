@@ -0,0 +1,340 @@
+#include "audio_pcm.h"
+#include "hardware/pwm.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+
+// Portadora PWM: TOP 255 com divisor 1 (~488 kHz, inaudível)
+#define TOP_MINIMO 255u
+// Limite do TOP ao atenuar pelo envelope (portadora ainda acima de 60 kHz)
+#define TOP_MAXIMO 2047u
+
+// Taxa de atualização do envelope (Hz)
+#define ENVELOPE_TAXA_HZ 1000
+
+//===============================================
+// Tabelas de onda (flash, alinhadas para o anel de leitura do DMA)
+//===============================================
+static const uint8_t __attribute__((aligned(AUDIO_TAM_TABELA))) tabela_seno[AUDIO_TAM_TABELA] = {
+    128, 140, 153, 165, 177, 188, 199, 209, 218, 226, 234, 240, 245, 250, 253, 254,
+    255, 254, 253, 250, 245, 240, 234, 226, 218, 209, 199, 188, 177, 165, 153, 140,
+    128, 116, 103,  91,  79,  68,  57,  47,  38,  30,  22,  16,  11,   6,   3,   2,
+      1,   2,   3,   6,  11,  16,  22,  30,  38,  47,  57,  68,  79,  91, 103, 116
+};
+
+static const uint8_t __attribute__((aligned(AUDIO_TAM_TABELA))) tabela_triangular[AUDIO_TAM_TABELA] = {
+    128, 136, 144, 152, 160, 168, 176, 184, 192, 199, 207, 215, 223, 231, 239, 247,
+    255, 247, 239, 231, 223, 215, 207, 199, 192, 184, 176, 168, 160, 152, 144, 136,
+    128, 120, 112, 104,  96,  88,  80,  72,  64,  57,  49,  41,  33,  25,  17,   9,
+      1,   9,  17,  25,  33,  41,  49,  57,  64,  72,  80,  88,  96, 104, 112, 120
+};
+
+// Quadrada com harmônicos ímpares até o 7º (bordas suavizadas)
+static const uint8_t __attribute__((aligned(AUDIO_TAM_TABELA))) tabela_quadrada_suave[AUDIO_TAM_TABELA] = {
+    128, 180, 222, 247, 255, 249, 238, 227, 224, 227, 234, 242, 244, 242, 235, 229,
+    227, 229, 235, 242, 244, 242, 234, 227, 224, 227, 238, 249, 255, 247, 222, 180,
+    128,  76,  34,   9,   1,   7,  18,  29,  32,  29,  22,  14,  12,  14,  21,  27,
+     29,  27,  21,  14,  12,  14,  22,  29,  32,  29,  18,   7,   1,   9,  34,  76
+};
+
+// Fundamental + 2º, 3º e 4º harmônicos com amplitudes decrescentes
+static const uint8_t __attribute__((aligned(AUDIO_TAM_TABELA))) tabela_orgao[AUDIO_TAM_TABELA] = {
+    128, 157, 184, 208, 228, 242, 251, 255, 254, 250, 242, 234, 224, 216, 208, 201,
+    196, 192, 189, 186, 183, 179, 174, 169, 163, 157, 151, 145, 140, 136, 133, 130,
+    128, 126, 123, 120, 116, 111, 105,  99,  93,  87,  82,  77,  73,  70,  67,  64,
+     60,  55,  48,  40,  32,  22,  14,   6,   2,   1,   5,  14,  28,  48,  72,  99
+};
+
+static const uint8_t *const tabelas[NUM_TIMBRES] = {
+    tabela_seno, tabela_triangular, tabela_quadrada_suave, tabela_orgao
+};
+
+//===============================================
+// Sons pré-definidos
+//===============================================
+static const NotaPcm notas_sucesso[] = {
+    {523, 200, TIMBRE_ORGAO},          // Do
+    {0,    20, TIMBRE_ORGAO},
+    {659, 200, TIMBRE_ORGAO},          // Mi
+    {0,    20, TIMBRE_ORGAO},
+    {784, 400, TIMBRE_ORGAO},          // Sol
+};
+const SomPcm SOM_SUCESSO = {notas_sucesso, count_of(notas_sucesso), 10, 60, 180, 80};
+
+static const NotaPcm notas_erro[] = {
+    {440, 200, TIMBRE_QUADRADA_SUAVE}, // Lá
+    {0,    50, TIMBRE_QUADRADA_SUAVE},
+    {349, 400, TIMBRE_QUADRADA_SUAVE}, // Fá
+};
+const SomPcm SOM_ERRO = {notas_erro, count_of(notas_erro), 5, 40, 200, 120};
+
+static const NotaPcm notas_bipe[] = {
+    {392, 100, TIMBRE_TRIANGULAR},     // Sol
+};
+const SomPcm SOM_BIPE = {notas_bipe, count_of(notas_bipe), 3, 20, 160, 40};
+
+static const NotaPcm notas_inicializacao[] = {
+    {523,  200, TIMBRE_SENO},          // Do
+    {0,     50, TIMBRE_SENO},
+    {659,  200, TIMBRE_SENO},          // Mi
+    {0,     50, TIMBRE_SENO},
+    {784,  200, TIMBRE_SENO},          // Sol
+    {0,     50, TIMBRE_SENO},
+    {1047, 400, TIMBRE_SENO},          // Do (oitava acima)
+};
+const SomPcm SOM_INICIALIZACAO = {notas_inicializacao, count_of(notas_inicializacao), 15, 80, 200, 150};
+
+//===============================================
+// Estado das vozes
+//===============================================
+typedef struct {
+    uint pino;
+    uint slice;
+    uint canal;
+    uint dma_amostra;     // Flash -> byte da palavra de comparação (8 bits, anel de leitura)
+    uint dma_saida;       // Palavra de comparação -> registrador CC do slice (32 bits)
+    uint timer_dma;       // Temporizador que dita a taxa de amostragem
+    uint16_t timer_x;     // Fração do temporizador para a nota atual
+    uint16_t timer_y;
+    bool mudo;            // Ganho zero: temporizador parado e comparação em 0
+    volatile uint32_t palavra_cc;
+    const SomPcm *som;
+    uint8_t nota;
+    uint8_t timbre;
+    uint16_t tempo_ms;
+    volatile bool tocando;
+} VozPcm;
+
+static VozPcm vozes[AUDIO_NUM_VOZES];
+static struct repeating_timer timer_envelope;
+static bool envelope_ativo = false;
+
+// Melhor aproximação racional x/y de num/den com x e y em 16 bits
+// (frações contínuas), usada para programar o temporizador do DMA.
+static void aproximar_fracao(uint32_t num, uint32_t den, uint16_t *x, uint16_t *y) {
+    uint64_t p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+    uint32_t n = num, d = den;
+    while (d != 0) {
+        uint32_t a = n / d;
+        uint64_t p2 = a * p1 + p0;
+        uint64_t q2 = a * q1 + q0;
+        if (p2 > 0xFFFF || q2 > 0xFFFF) break;
+        p0 = p1; q0 = q1;
+        p1 = p2; q1 = q2;
+        uint32_t r = n - a * d;
+        n = d;
+        d = r;
+    }
+    if (q1 == 0) q1 = 0xFFFF;
+    if (p1 == 0) p1 = 1;
+    *x = (uint16_t)p1;
+    *y = (uint16_t)q1;
+}
+
+// Ganho do envelope (0-255) no instante atual da nota
+static uint32_t calcular_ganho(const SomPcm *som, uint32_t t, uint32_t duracao) {
+    uint32_t ganho;
+    if (t < som->ataque_ms) {
+        ganho = (255u * t) / som->ataque_ms;
+    } else if (t < (uint32_t)som->ataque_ms + som->decaimento_ms) {
+        uint32_t td = t - som->ataque_ms;
+        ganho = 255u - ((255u - som->sustentacao) * td) / som->decaimento_ms;
+    } else {
+        ganho = som->sustentacao;
+    }
+
+    if (duracao > som->liberacao_ms && t > duracao - som->liberacao_ms) {
+        uint32_t restante = duracao - t;
+        ganho = (ganho * restante) / som->liberacao_ms;
+    }
+    return ganho;
+}
+
+// Para o temporizador e estaciona a comparação em 0. Uma transferência já
+// requisitada ainda pode escrever depois; por isso o envelope repete isto a
+// cada tick enquanto a voz estiver muda.
+static void silenciar(VozPcm *v) {
+    dma_timer_set_fraction(v->timer_dma, 0, 0xFFFF);
+    v->palavra_cc = 0;
+    pwm_set_chan_level(v->slice, v->canal, 0);
+    v->mudo = true;
+}
+
+// O ganho é aplicado pelo TOP do PWM: como as amostras vão de 0 a 255,
+// um TOP maior reduz o ciclo útil de todas elas na mesma proporção. O TOP
+// para em TOP_MAXIMO (cerca de 1/8 do ciclo), então o ganho zero não passa
+// pelo TOP: a voz fica muda até o ganho voltar.
+static void aplicar_ganho(VozPcm *v, uint32_t ganho) {
+    if (ganho == 0) {
+        silenciar(v);
+        return;
+    }
+    uint32_t top = (TOP_MINIMO * 255u) / ganho;
+    if (top < TOP_MINIMO) top = TOP_MINIMO;
+    if (top > TOP_MAXIMO) top = TOP_MAXIMO;
+    pwm_set_wrap(v->slice, top);
+    if (v->mudo) {
+        v->mudo = false;
+        dma_timer_set_fraction(v->timer_dma, v->timer_x, v->timer_y);
+    }
+}
+
+static void iniciar_nota(VozPcm *v) {
+    const NotaPcm *n = &v->som->notas[v->nota];
+    v->tempo_ms = 0;
+
+    if (n->freq == 0) {
+        // Pausa: o temporizador para de gerar requisições e a saída fica em zero
+        silenciar(v);
+        return;
+    }
+
+    if (n->timbre != v->timbre) {
+        v->timbre = n->timbre;
+        dma_channel_abort(v->dma_amostra);
+        dma_channel_set_read_addr(v->dma_amostra, tabelas[v->timbre], false);
+        dma_channel_set_trans_count(v->dma_amostra, 0xFFFFFFFFu, true);
+    }
+
+    // A nota começa muda (ganho zero no início do ataque); o temporizador
+    // parte com a fração dela no primeiro ganho positivo
+    aproximar_fracao(n->freq * AUDIO_TAM_TABELA, clock_get_hz(clk_sys), &v->timer_x, &v->timer_y);
+    aplicar_ganho(v, 0);
+}
+
+static void finalizar_voz(VozPcm *v) {
+    dma_timer_set_fraction(v->timer_dma, 0, 0xFFFF);
+    dma_channel_abort(v->dma_amostra);
+    dma_channel_abort(v->dma_saida);
+    v->palavra_cc = 0;
+
+    pwm_set_enabled(v->slice, false);
+    gpio_set_function(v->pino, GPIO_FUNC_SIO);
+    gpio_set_dir(v->pino, GPIO_OUT);
+    gpio_put(v->pino, 0);
+    v->tocando = false;
+}
+
+// Callback de controle (1 kHz): avança envelope e notas. Nenhum trabalho
+// por amostra é feito na CPU; as amostras fluem apenas pelo DMA.
+static bool envelope_tick(struct repeating_timer *t) {
+    bool alguma_ativa = false;
+
+    for (int i = 0; i < AUDIO_NUM_VOZES; i++) {
+        VozPcm *v = &vozes[i];
+        if (!v->tocando) continue;
+
+        const NotaPcm *n = &v->som->notas[v->nota];
+        v->tempo_ms++;
+
+        if (v->tempo_ms >= n->duracao_ms) {
+            v->nota++;
+            if (v->nota >= v->som->num_notas) {
+                finalizar_voz(v);
+                continue;
+            }
+            iniciar_nota(v);
+        } else if (n->freq != 0) {
+            aplicar_ganho(v, calcular_ganho(v->som, v->tempo_ms, n->duracao_ms));
+        } else {
+            silenciar(v);
+        }
+        alguma_ativa = true;
+    }
+
+    envelope_ativo = alguma_ativa;
+    return alguma_ativa;
+}
+
+static void configurar_voz(VozPcm *v, uint gpio) {
+    v->pino = gpio;
+    v->slice = pwm_gpio_to_slice_num(gpio);
+    v->canal = pwm_gpio_to_channel(gpio);
+    v->dma_amostra = dma_claim_unused_channel(true);
+    v->dma_saida = dma_claim_unused_channel(true);
+    v->timer_dma = dma_claim_unused_timer(true);
+    v->tocando = false;
+}
+
+void audio_pcm_init(uint gpio_principal, uint gpio_alerta) {
+    configurar_voz(&vozes[AUDIO_VOZ_PRINCIPAL], gpio_principal);
+    configurar_voz(&vozes[AUDIO_VOZ_ALERTA], gpio_alerta);
+}
+
+void audio_pcm_tocar(uint voz, const SomPcm *som) {
+    if (voz >= AUDIO_NUM_VOZES || som->num_notas == 0) return;
+    VozPcm *v = &vozes[voz];
+
+    // Pode ser chamada do loop principal ou de ISRs (botões)
+    uint32_t irq = save_and_disable_interrupts();
+
+    if (v->tocando) {
+        dma_channel_abort(v->dma_amostra);
+        dma_channel_abort(v->dma_saida);
+    }
+
+    v->som = som;
+    v->nota = 0;
+    v->timbre = som->notas[0].timbre;
+    v->palavra_cc = 0;
+
+    gpio_set_function(v->pino, GPIO_FUNC_PWM);
+    pwm_set_clkdiv(v->slice, 1.0f);
+    pwm_set_wrap(v->slice, TOP_MAXIMO);
+    pwm_set_chan_level(v->slice, v->canal, 0);
+    pwm_set_enabled(v->slice, true);
+
+    // Leituras de 8 bits da tabela em anel; a amostra cai no byte da palavra
+    // correspondente ao canal do slice (A: bits 0-15, B: bits 16-31)
+    uint dreq = dma_get_timer_dreq(v->timer_dma);
+    volatile uint8_t *destino = (volatile uint8_t *)&v->palavra_cc + (v->canal == PWM_CHAN_B ? 2 : 0);
+
+    dma_channel_config ca = dma_channel_get_default_config(v->dma_amostra);
+    channel_config_set_transfer_data_size(&ca, DMA_SIZE_8);
+    channel_config_set_read_increment(&ca, true);
+    channel_config_set_write_increment(&ca, false);
+    channel_config_set_ring(&ca, false, AUDIO_TAM_TABELA_LOG2);
+    channel_config_set_dreq(&ca, dreq);
+    dma_channel_configure(v->dma_amostra, &ca, destino, tabelas[v->timbre], 0xFFFFFFFFu, false);
+
+    // Escritas de 32 bits no CC: o outro canal do slice fica em zero
+    // (GPIO 11 é digital e GPIO 20 não é usado)
+    dma_channel_config cs = dma_channel_get_default_config(v->dma_saida);
+    channel_config_set_transfer_data_size(&cs, DMA_SIZE_32);
+    channel_config_set_read_increment(&cs, false);
+    channel_config_set_write_increment(&cs, false);
+    channel_config_set_dreq(&cs, dreq);
+    dma_channel_configure(v->dma_saida, &cs, &pwm_hw->slice[v->slice].cc, &v->palavra_cc, 0xFFFFFFFFu, false);
+
+    iniciar_nota(v);
+    dma_start_channel_mask((1u << v->dma_amostra) | (1u << v->dma_saida));
+    v->tocando = true;
+
+    if (!envelope_ativo) {
+        envelope_ativo = true;
+        add_repeating_timer_us(-(int64_t)(1000000 / ENVELOPE_TAXA_HZ), envelope_tick, NULL, &timer_envelope);
+    }
+
+    restore_interrupts(irq);
+}
+
+void audio_pcm_parar(uint voz) {
+    if (voz >= AUDIO_NUM_VOZES) return;
+    uint32_t irq = save_and_disable_interrupts();
+    if (vozes[voz].tocando) {
+        finalizar_voz(&vozes[voz]);
+    }
+    restore_interrupts(irq);
+}
+
+bool audio_pcm_tocando(uint voz) {
+    return voz < AUDIO_NUM_VOZES && vozes[voz].tocando;
+}
+
+uint32_t audio_pcm_duracao_ms(const SomPcm *som) {
+    uint32_t total = 0;
+    for (int i = 0; i < som->num_notas; i++) {
+        total += som->notas[i].duracao_ms;
+    }
+    return total;
+}
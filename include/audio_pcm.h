@@ -0,0 +1,65 @@
+#ifndef AUDIO_PCM_H
+#define AUDIO_PCM_H
+
+#include "pico/stdlib.h"
+
+// Sons PCM de tabela de onda no PWM dos buzzers, sem CPU por amostra: um
+// canal de DMA lê a tabela em anel e outro copia a amostra para o registrador
+// de comparação, ambos no ritmo de um temporizador de DMA.
+//
+// A taxa de amostragem não é fixa: o temporizador é reprogramado a cada
+// nota para freq * AUDIO_TAM_TABELA (64 amostras por período), e é isso que
+// dá a altura, sem acumulador de fase na CPU. Limites: a taxa vai de 6,4 kHz
+// (100 Hz) a cerca de 67 kHz (1047 Hz); acima de ~950 Hz ela passa da
+// portadora do PWM no ganho mínimo (TOP_MAXIMO, ~61 kHz) e parte das amostras
+// se perde; a altura vem da fração x/y de 16 bits do temporizador (erro
+// abaixo de 0,01% nas notas usadas). O ganho zero para o temporizador e deixa
+// a saída em 0.
+
+// Vozes de saída (uma por buzzer)
+#define AUDIO_VOZ_PRINCIPAL 0   // BUZZER1_PIN
+#define AUDIO_VOZ_ALERTA    1   // BUZZER2_PIN
+#define AUDIO_NUM_VOZES     2
+
+// Amostras por período de cada tabela de onda (potência de 2 para o anel do DMA)
+#define AUDIO_TAM_TABELA_LOG2 6
+#define AUDIO_TAM_TABELA (1u << AUDIO_TAM_TABELA_LOG2)
+
+// Timbres disponíveis (tabelas de 8 bits em flash)
+typedef enum {
+    TIMBRE_SENO = 0,
+    TIMBRE_TRIANGULAR,
+    TIMBRE_QUADRADA_SUAVE,
+    TIMBRE_ORGAO,
+    NUM_TIMBRES
+} Timbre;
+
+// Uma nota de um som: frequência 0 representa pausa
+typedef struct {
+    uint16_t freq;
+    uint16_t duracao_ms;
+    uint8_t timbre;
+} NotaPcm;
+
+// Som completo: sequência de notas com envelope ADSR aplicado a cada nota
+typedef struct {
+    const NotaPcm *notas;
+    uint8_t num_notas;
+    uint8_t ataque_ms;
+    uint8_t decaimento_ms;
+    uint8_t sustentacao;     // Ganho de sustentação (0-255)
+    uint8_t liberacao_ms;
+} SomPcm;
+
+extern const SomPcm SOM_SUCESSO;
+extern const SomPcm SOM_ERRO;
+extern const SomPcm SOM_BIPE;
+extern const SomPcm SOM_INICIALIZACAO;
+
+void audio_pcm_init(uint gpio_principal, uint gpio_alerta);
+void audio_pcm_tocar(uint voz, const SomPcm *som);
+void audio_pcm_parar(uint voz);
+bool audio_pcm_tocando(uint voz);
+uint32_t audio_pcm_duracao_ms(const SomPcm *som);
+
+#endif
@@ -0,0 +1,101 @@
+#include "biquad.h"
+#include <string.h>
+
+// Coeficientes Q30 projetados offline (RBJ Audio EQ Cookbook) para as taxas
+// de saída suportadas pela aquisição. Ordem: b0, b1, b2, a1, a2.
+static const BiquadCoef coef_250hz[NUM_FILTROS] = {
+    [FILTRO_PA_0_5HZ]   = {1064242979, -2128485958, 1064242979, -2128401927, 1054828166},
+    [FILTRO_NOTCH_50HZ] = {1025000169,  -633484943, 1025000169,  -633484943,  976258515},
+    [FILTRO_NOTCH_60HZ] = {1022707360,  -128432653, 1022707360,  -128432653,  971672896},
+    [FILTRO_PB_40HZ]    = { 156039773,   312079545,  156039773,  -720509417,  270926684},
+    [FILTRO_PB_5HZ]     = {   3888748,     7777496,    3888748, -1957102246,  898915413},
+};
+
+static const BiquadCoef coef_500hz[NUM_FILTROS] = {
+    [FILTRO_PA_0_5HZ]   = {1068981851, -2137963702, 1068981851, -2137942601, 1064242979},
+    [FILTRO_NOTCH_50HZ] = {1043086287, -1687749066, 1043086287, -1687749066, 1012430750},
+    [FILTRO_NOTCH_60HZ] = {1038206753, -1513640303, 1038206753, -1513640303, 1002671681},
+    [FILTRO_PB_40HZ]    = {  49533525,    99067049,   49533525, -1403683191,  528075465},
+    [FILTRO_PB_5HZ]     = {   1014355,     2028709,    1014355, -2052131389,  982446983},
+};
+
+static const BiquadCoef coef_1000hz[NUM_FILTROS] = {
+    [FILTRO_PA_0_5HZ]   = {1071359194, -2142718388, 1071359194, -2142713101, 1068981851},
+    [FILTRO_NOTCH_50HZ] = {1057404033, -2011301992, 1057404033, -2011301992, 1041066242},
+    [FILTRO_NOTCH_60HZ] = {1054335485, -1960592684, 1054335485, -1960592684, 1034929146},
+    [FILTRO_PB_40HZ]    = {  14344311,    28688622,   14344311, -1768944148,  752579569},
+    [FILTRO_PB_5HZ]     = {    259157,      518315,     259157, -2099785709, 1027080514},
+};
+
+// Retorna os coeficientes do projeto para a taxa, ou NULL se não houver
+const BiquadCoef *biquad_projeto(FiltroProjeto filtro, uint32_t taxa_amostragem_hz) {
+    if (filtro >= NUM_FILTROS) return NULL;
+    switch (taxa_amostragem_hz) {
+        case 250:  return &coef_250hz[filtro];
+        case 500:  return &coef_500hz[filtro];
+        case 1000: return &coef_1000hz[filtro];
+        default:   return NULL;
+    }
+}
+
+void biquad_cascata_init(BiquadCascata *c) {
+    memset(c, 0, sizeof(*c));
+}
+
+bool biquad_cascata_adicionar(BiquadCascata *c, const BiquadCoef *coef) {
+    if (coef == NULL || c->num_secoes >= BIQUAD_MAX_SECOES) return false;
+    BiquadSecao *s = &c->secoes[c->num_secoes++];
+    memset(s, 0, sizeof(*s));
+    s->coef = coef;
+    return true;
+}
+
+// Coloca cada seção em regime permanente para uma entrada constante,
+// evitando o transiente longo do passa-altas na partida
+void biquad_cascata_reiniciar(BiquadCascata *c, int32_t valor_inicial) {
+    int64_t v = valor_inicial;
+    for (int i = 0; i < c->num_secoes; i++) {
+        BiquadSecao *s = &c->secoes[i];
+        const BiquadCoef *k = s->coef;
+        int64_t num = (int64_t)k->b0 + k->b1 + k->b2;
+        int64_t den = (1LL << BIQUAD_FRAC) + k->a1 + k->a2;
+        int64_t saida = den ? (v * num) / den : 0;
+        s->x1 = s->x2 = (int32_t)v;
+        s->y1 = s->y2 = (int32_t)saida;
+        s->erro = 0;
+        v = saida;
+    }
+}
+
+// Filtra um bloco in-place (passo em elementos, para dados intercalados).
+// Cada seção percorre o bloco inteiro antes da próxima, mantendo o estado
+// em registradores durante o laço.
+void biquad_processar_bloco(BiquadCascata *c, int32_t *amostras, uint32_t num, uint32_t passo) {
+    const int64_t mascara = (1LL << BIQUAD_FRAC) - 1;
+
+    for (int i = 0; i < c->num_secoes; i++) {
+        BiquadSecao *s = &c->secoes[i];
+        const int32_t b0 = s->coef->b0, b1 = s->coef->b1, b2 = s->coef->b2;
+        const int32_t a1 = s->coef->a1, a2 = s->coef->a2;
+        int32_t x1 = s->x1, x2 = s->x2, y1 = s->y1, y2 = s->y2;
+        int64_t erro = s->erro;
+
+        int32_t *p = amostras;
+        for (uint32_t n = 0; n < num; n++) {
+            int32_t x = *p;
+            int64_t acc = erro
+                        + (int64_t)b0 * x + (int64_t)b1 * x1 + (int64_t)b2 * x2
+                        - (int64_t)a1 * y1 - (int64_t)a2 * y2;
+            int32_t y = (int32_t)(acc >> BIQUAD_FRAC);
+            erro = acc & mascara;
+
+            x2 = x1; x1 = x;
+            y2 = y1; y1 = y;
+            *p = y;
+            p += passo;
+        }
+
+        s->x1 = x1; s->x2 = x2; s->y1 = y1; s->y2 = y2;
+        s->erro = erro;
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef BIQUAD_H
+#define BIQUAD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Seções biquad em forma direta I com coeficientes Q30 e acumulador de
+// 64 bits. O resto da truncagem é realimentado na amostra seguinte, o que
+// mantém estáveis os polos muito próximos de 1 do passa-altas de 0.5 Hz.
+#define BIQUAD_FRAC 30
+#define BIQUAD_MAX_SECOES 4
+
+// Projetos disponíveis (coeficientes calculados offline, RBJ)
+typedef enum {
+    FILTRO_PA_0_5HZ = 0,   // Passa-altas Butterworth: remove DC e deriva
+    FILTRO_NOTCH_50HZ,     // Rejeita-faixa da rede, Q = 10
+    FILTRO_NOTCH_60HZ,
+    FILTRO_PB_40HZ,        // Passa-baixas Butterworth: limita à faixa do EEG
+    FILTRO_PB_5HZ,         // Passa-baixas Butterworth: sinais lentos (GSR)
+    NUM_FILTROS
+} FiltroProjeto;
+
+typedef struct {
+    int32_t b0, b1, b2, a1, a2;   // Q30, com a0 = 1
+} BiquadCoef;
+
+typedef struct {
+    const BiquadCoef *coef;
+    int32_t x1, x2, y1, y2;
+    int64_t erro;
+} BiquadSecao;
+
+typedef struct {
+    BiquadSecao secoes[BIQUAD_MAX_SECOES];
+    uint8_t num_secoes;
+} BiquadCascata;
+
+const BiquadCoef *biquad_projeto(FiltroProjeto filtro, uint32_t taxa_amostragem_hz);
+void biquad_cascata_init(BiquadCascata *c);
+bool biquad_cascata_adicionar(BiquadCascata *c, const BiquadCoef *coef);
+void biquad_cascata_reiniciar(BiquadCascata *c, int32_t valor_inicial);
+void biquad_processar_bloco(BiquadCascata *c, int32_t *amostras, uint32_t num, uint32_t passo);
+
+#endif
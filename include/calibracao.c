@@ -0,0 +1,49 @@
+#include "calibracao.h"
+
+// Saída da curva calibrada para uma entrada bruta, sem a tabela
+static uint16_t curva(uint32_t x, uint32_t baixo, uint32_t meio, uint32_t alto, uint32_t fundo_escala) {
+    uint32_t metade = fundo_escala / 2;
+    if (x <= baixo) return 0;
+    if (x >= alto) return (uint16_t)fundo_escala;
+    if (x < meio) return (uint16_t)((x - baixo) * metade / (meio - baixo));
+    return (uint16_t)(metade + (x - meio) * (fundo_escala - metade) / (alto - meio));
+}
+
+void calibracao_identidade(CalibracaoCanal *c, uint16_t fundo_escala) {
+    c->medidos[CALIBRACAO_PONTO_MIN] = 0;
+    c->medidos[CALIBRACAO_PONTO_MEIO] = fundo_escala / 2;
+    c->medidos[CALIBRACAO_PONTO_MAX] = fundo_escala;
+    for (uint32_t k = 0; k <= CALIBRACAO_SEGMENTOS; k++) {
+        uint32_t x = k << CALIBRACAO_DESLOCAMENTO;
+        c->lut[k] = (uint16_t)(x > fundo_escala ? fundo_escala : x);
+    }
+}
+
+void calibracao_definir_ponto(CalibracaoCanal *c, PontoCalibracao ponto, uint16_t bruto) {
+    if (ponto < CALIBRACAO_NUM_PONTOS) c->medidos[ponto] = bruto;
+}
+
+// Monta a tabela a partir dos pontos medidos. Retorna false (sem alterar a
+// tabela) se os pontos estiverem fora de ordem ou o curso for curto demais.
+bool calibracao_construir(CalibracaoCanal *c, uint16_t fundo_escala) {
+    uint32_t min = c->medidos[CALIBRACAO_PONTO_MIN];
+    uint32_t meio = c->medidos[CALIBRACAO_PONTO_MEIO];
+    uint32_t max = c->medidos[CALIBRACAO_PONTO_MAX];
+
+    if (max <= min) return false;
+    uint32_t curso = max - min;
+    if (curso * 100 < (uint32_t)fundo_escala * CALIBRACAO_CURSO_MIN_PCT) return false;
+
+    // O meio precisa ficar fora das zonas mortas com folga
+    uint32_t margem = curso / 10;
+    if (meio < min + margem || meio > max - margem) return false;
+
+    uint32_t zona_morta = curso * CALIBRACAO_ZONA_MORTA_PCT / 100;
+    uint32_t baixo = min + zona_morta;
+    uint32_t alto = max - zona_morta;
+
+    for (uint32_t k = 0; k <= CALIBRACAO_SEGMENTOS; k++) {
+        c->lut[k] = curva(k << CALIBRACAO_DESLOCAMENTO, baixo, meio, alto, fundo_escala);
+    }
+    return true;
+}
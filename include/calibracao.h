@@ -0,0 +1,45 @@
+#ifndef CALIBRACAO_H
+#define CALIBRACAO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Correção por canal das amostras de 16 bits: três pontos capturados
+// (mínimo, meio e máximo do potenciômetro) definem uma curva linear por
+// partes com zona morta nos extremos, tabelada em 33 pontos. A aplicação é
+// uma consulta com interpolação linear, em tempo constante.
+#define CALIBRACAO_SEGMENTOS_LOG2 5
+#define CALIBRACAO_SEGMENTOS (1u << CALIBRACAO_SEGMENTOS_LOG2)
+#define CALIBRACAO_DESLOCAMENTO (16 - CALIBRACAO_SEGMENTOS_LOG2)
+
+// Zona morta em cada extremo, em % do curso medido
+#define CALIBRACAO_ZONA_MORTA_PCT 2
+
+// Curso mínimo (em % do fundo de escala) para aceitar uma calibração
+#define CALIBRACAO_CURSO_MIN_PCT 25
+
+typedef enum {
+    CALIBRACAO_PONTO_MIN = 0,
+    CALIBRACAO_PONTO_MEIO,
+    CALIBRACAO_PONTO_MAX,
+    CALIBRACAO_NUM_PONTOS
+} PontoCalibracao;
+
+typedef struct {
+    uint16_t medidos[CALIBRACAO_NUM_PONTOS];   // Leituras brutas capturadas
+    uint16_t lut[CALIBRACAO_SEGMENTOS + 1];    // Saída nos pontos k << CALIBRACAO_DESLOCAMENTO
+} CalibracaoCanal;
+
+void calibracao_identidade(CalibracaoCanal *c, uint16_t fundo_escala);
+void calibracao_definir_ponto(CalibracaoCanal *c, PontoCalibracao ponto, uint16_t bruto);
+bool calibracao_construir(CalibracaoCanal *c, uint16_t fundo_escala);
+
+static inline uint16_t calibracao_aplicar(const CalibracaoCanal *c, uint16_t bruto) {
+    uint32_t i = bruto >> CALIBRACAO_DESLOCAMENTO;
+    int32_t frac = bruto & ((1u << CALIBRACAO_DESLOCAMENTO) - 1);
+    int32_t a = c->lut[i];
+    int32_t b = c->lut[i + 1];
+    return (uint16_t)(a + (((b - a) * frac) >> CALIBRACAO_DESLOCAMENTO));
+}
+
+#endif
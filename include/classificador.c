@@ -0,0 +1,113 @@
+#include "classificador.h"
+#include <string.h>
+
+enum { ZONA_BAIXA = 0, ZONA_MEDIA, ZONA_ALTA, NUM_ZONAS };
+
+// Estado de cada combinação [zona da atenção][zona do relaxamento]
+static const uint8_t regioes[NUM_ZONAS][NUM_ZONAS] = {
+    [ZONA_BAIXA] = {ESTADO_DISTRAIDO, ESTADO_DISTRAIDO, ESTADO_DISTRAIDO},
+    [ZONA_MEDIA] = {ESTADO_NORMAL, ESTADO_NORMAL, ESTADO_RELAXADO},
+    [ZONA_ALTA]  = {ESTADO_ANSIOSO, ESTADO_CONCENTRADO, ESTADO_FLOW},
+};
+
+static const char *const nomes[NUM_ESTADOS_COGNITIVOS] = {
+    [ESTADO_DISTRAIDO] = "Distraido",
+    [ESTADO_NORMAL] = "Normal",
+    [ESTADO_CONCENTRADO] = "Concentrado",
+    [ESTADO_RELAXADO] = "Relaxado",
+    [ESTADO_FLOW] = "Estado Flow",
+    [ESTADO_ANSIOSO] = "Ansioso",
+};
+
+void classificador_init(ClassificadorCognitivo *c, const ConfigClassificador *cfg) {
+    memset(c, 0, sizeof(*c));
+    c->cfg = *cfg;
+    c->estado = ESTADO_NORMAL;
+    c->candidato = ESTADO_NORMAL;
+}
+
+// Zona do valor a partir da zona atual: os limiares da zona em que o valor
+// já está descem pela largura da histerese
+static uint8_t zona(q16_t v, uint8_t atual, q16_t baixo, q16_t alto, q16_t hist_baixo, q16_t hist_alto) {
+    if (atual >= ZONA_MEDIA) baixo = q16_subtrair(baixo, hist_baixo);
+    if (atual == ZONA_ALTA) alto = q16_subtrair(alto, hist_alto);
+    if (q16_comparar(v, alto) >= 0) return ZONA_ALTA;
+    if (q16_comparar(v, baixo) >= 0) return ZONA_MEDIA;
+    return ZONA_BAIXA;
+}
+
+// Move as zonas de atenção e relaxamento com a histerese e retorna o estado
+// da tabela de regiões para elas, sem passar pela permanência
+EstadoMental classificador_atualizar_zonas(ClassificadorCognitivo *c, q16_t atencao, q16_t relaxamento,
+                                           const q16_t limiares[NUM_LIMIARES]) {
+    const q16_t *h = c->cfg.histerese;
+    if (!c->iniciado) {
+        // Sem histórico, sem histerese
+        c->zona_atencao = ZONA_BAIXA;
+        c->zona_relaxamento = ZONA_BAIXA;
+    }
+    c->zona_atencao = zona(atencao, c->zona_atencao,
+                           limiares[LIMIAR_ATENCAO_BAIXO], limiares[LIMIAR_ATENCAO_ALTO],
+                           h[LIMIAR_ATENCAO_BAIXO], h[LIMIAR_ATENCAO_ALTO]);
+    c->zona_relaxamento = zona(relaxamento, c->zona_relaxamento,
+                               limiares[LIMIAR_RELAXAMENTO_BAIXO], limiares[LIMIAR_RELAXAMENTO_ALTO],
+                               h[LIMIAR_RELAXAMENTO_BAIXO], h[LIMIAR_RELAXAMENTO_ALTO]);
+    return (EstadoMental)regioes[c->zona_atencao][c->zona_relaxamento];
+}
+
+// Classifica os níveis atuais; retorna true (e preenche *evento) quando um
+// novo estado é aceito. A primeira chamada adota o estado sem evento.
+bool classificador_atualizar(ClassificadorCognitivo *c, q16_t atencao, q16_t relaxamento,
+                             const q16_t limiares[NUM_LIMIARES], uint64_t agora_us,
+                             EventoTransicao *evento) {
+    EstadoMental regiao = classificador_atualizar_zonas(c, atencao, relaxamento, limiares);
+    return classificador_aceitar(c, regiao, agora_us, evento);
+}
+
+// Submete um estado candidato vindo de outro classificador (o modelo
+// treinado) à mesma regra de permanência. Não mexe nas zonas: quem usa outro
+// classificador chama classificador_atualizar_zonas antes, para a tabela de
+// regiões retomar com a histerese em dia.
+bool classificador_aceitar(ClassificadorCognitivo *c, EstadoMental novo, uint64_t agora_us,
+                           EventoTransicao *evento) {
+    if (!c->iniciado) {
+        c->estado = novo;
+        c->candidato = novo;
+        c->inicio_estado_us = agora_us;
+        c->inicio_candidato_us = agora_us;
+        c->iniciado = true;
+        return false;
+    }
+
+    if (novo == c->estado) {
+        c->candidato = novo;
+        return false;
+    }
+    if (novo != c->candidato) {
+        c->candidato = novo;
+        c->inicio_candidato_us = agora_us;
+    }
+    if (agora_us - c->inicio_candidato_us < c->cfg.permanencia_min_us[novo]) return false;
+
+    // O novo estado vale desde que o candidato apareceu
+    evento->de = c->estado;
+    evento->para = novo;
+    evento->instante_us = c->inicio_candidato_us;
+    evento->duracao_us = c->inicio_candidato_us - c->inicio_estado_us;
+    c->estado = novo;
+    c->inicio_estado_us = c->inicio_candidato_us;
+    return true;
+}
+
+// Estado da tabela de regiões para os níveis dados, sem histerese nem
+// permanência (rótulo de referência para gravações)
+EstadoMental classificador_regiao(q16_t atencao, q16_t relaxamento, const q16_t limiares[NUM_LIMIARES]) {
+    uint8_t za = zona(atencao, ZONA_BAIXA, limiares[LIMIAR_ATENCAO_BAIXO], limiares[LIMIAR_ATENCAO_ALTO], Q16_ZERO, Q16_ZERO);
+    uint8_t zr = zona(relaxamento, ZONA_BAIXA, limiares[LIMIAR_RELAXAMENTO_BAIXO],
+                      limiares[LIMIAR_RELAXAMENTO_ALTO], Q16_ZERO, Q16_ZERO);
+    return (EstadoMental)regioes[za][zr];
+}
+
+const char *classificador_nome(EstadoMental estado) {
+    return estado < NUM_ESTADOS_COGNITIVOS ? nomes[estado] : "Desconhecido";
+}
@@ -0,0 +1,67 @@
+#ifndef CLASSIFICADOR_H
+#define CLASSIFICADOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fixo.h"
+
+// Classificador do estado cognitivo por tabela de regiões: atenção e
+// relaxamento caem cada um numa de três zonas (baixa, média, alta) e a
+// tabela dá o estado de cada combinação. Cada limiar tem uma faixa de
+// histerese abaixo dele (entrar na zona exige cruzar o limiar; sair exige
+// cair abaixo de limiar - histerese), e um estado candidato só é aceito
+// depois de se manter pelo tempo mínimo de permanência dele. As mudanças
+// viram eventos de transição. Não depende do SDK.
+typedef enum {
+    ESTADO_DISTRAIDO = 0,   // Atenção baixa
+    ESTADO_NORMAL,
+    ESTADO_CONCENTRADO,     // Atenção alta
+    ESTADO_RELAXADO,        // Relaxamento alto
+    ESTADO_FLOW,            // Atenção alta + relaxamento alto
+    ESTADO_ANSIOSO,         // Atenção alta + relaxamento baixo
+    NUM_ESTADOS_COGNITIVOS
+} EstadoMental;
+
+typedef enum {
+    LIMIAR_ATENCAO_BAIXO = 0,
+    LIMIAR_ATENCAO_ALTO,
+    LIMIAR_RELAXAMENTO_BAIXO,
+    LIMIAR_RELAXAMENTO_ALTO,
+    NUM_LIMIARES
+} LimiarCognitivo;
+
+typedef struct {
+    q16_t histerese[NUM_LIMIARES];                          // Largura da faixa abaixo de cada limiar
+    uint32_t permanencia_min_us[NUM_ESTADOS_COGNITIVOS];    // Tempo para aceitar cada estado
+} ConfigClassificador;
+
+typedef struct {
+    EstadoMental de;
+    EstadoMental para;
+    uint64_t instante_us;       // Instante em que a transição foi aceita
+    uint64_t duracao_us;        // Tempo passado no estado anterior
+} EventoTransicao;
+
+typedef struct {
+    ConfigClassificador cfg;
+    uint8_t zona_atencao;
+    uint8_t zona_relaxamento;
+    EstadoMental estado;
+    EstadoMental candidato;
+    uint64_t inicio_estado_us;
+    uint64_t inicio_candidato_us;
+    bool iniciado;
+} ClassificadorCognitivo;
+
+void classificador_init(ClassificadorCognitivo *c, const ConfigClassificador *cfg);
+bool classificador_atualizar(ClassificadorCognitivo *c, q16_t atencao, q16_t relaxamento,
+                             const q16_t limiares[NUM_LIMIARES], uint64_t agora_us,
+                             EventoTransicao *evento);
+EstadoMental classificador_atualizar_zonas(ClassificadorCognitivo *c, q16_t atencao, q16_t relaxamento,
+                                           const q16_t limiares[NUM_LIMIARES]);
+bool classificador_aceitar(ClassificadorCognitivo *c, EstadoMental novo, uint64_t agora_us,
+                           EventoTransicao *evento);
+EstadoMental classificador_regiao(q16_t atencao, q16_t relaxamento, const q16_t limiares[NUM_LIMIARES]);
+const char *classificador_nome(EstadoMental estado);
+
+#endif
@@ -0,0 +1,48 @@
+#include "decimador.h"
+#include <string.h>
+
+void decimador_init(DecimadorCic *d) {
+    memset(d, 0, sizeof(*d));
+}
+
+// Processa um bloco de amostras de um canal. Entrada e saída podem estar
+// intercaladas com outros canais (passo em elementos). Toda a aritmética é
+// inteira e modular em 32 bits: o estouro dos integradores é compensado
+// exatamente pelos pentes, então não há saturação nem acúmulo de erro.
+// Retorna o número de amostras escritas na saída.
+uint32_t decimador_processar(DecimadorCic *d, const uint16_t *entrada, uint32_t num_entrada,
+                             uint32_t passo_entrada, uint16_t *saida, uint32_t passo_saida) {
+    uint32_t i0 = d->integrador[0];
+    uint32_t i1 = d->integrador[1];
+    uint32_t i2 = d->integrador[2];
+    uint32_t fase = d->fase;
+    uint32_t produzidas = 0;
+
+    for (uint32_t n = 0; n < num_entrada; n++) {
+        i0 += *entrada;
+        i1 += i0;
+        i2 += i1;
+        entrada += passo_entrada;
+
+        if (++fase < DECIMADOR_FATOR) continue;
+        fase = 0;
+
+        // Pentes à taxa de saída (atraso diferencial M = 1)
+        uint32_t c0 = i2 - d->pente[0];
+        d->pente[0] = i2;
+        uint32_t c1 = c0 - d->pente[1];
+        d->pente[1] = c0;
+        uint32_t c2 = c1 - d->pente[2];
+        d->pente[2] = c1;
+
+        *saida = (uint16_t)(c2 >> DECIMADOR_DESLOCAMENTO);
+        saida += passo_saida;
+        produzidas++;
+    }
+
+    d->integrador[0] = i0;
+    d->integrador[1] = i1;
+    d->integrador[2] = i2;
+    d->fase = fase;
+    return produzidas;
+}
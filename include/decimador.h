@@ -0,0 +1,24 @@
+#ifndef DECIMADOR_H
+#define DECIMADOR_H
+
+#include <stdint.h>
+
+// Filtro CIC (integrador-pente em cascata) de ordem 3, fator de decimação 16.
+// Ganho R^N = 2^12: entradas de 12 bits viram saídas de 16 bits após o
+// deslocamento de 8 bits (4 bits extras de resolução com a média).
+#define DECIMADOR_ORDEM 3
+#define DECIMADOR_FATOR_LOG2 4
+#define DECIMADOR_FATOR (1u << DECIMADOR_FATOR_LOG2)
+#define DECIMADOR_DESLOCAMENTO (DECIMADOR_ORDEM * DECIMADOR_FATOR_LOG2 - 4)
+
+typedef struct {
+    uint32_t integrador[DECIMADOR_ORDEM];
+    uint32_t pente[DECIMADOR_ORDEM];
+    uint32_t fase;
+} DecimadorCic;
+
+void decimador_init(DecimadorCic *d);
+uint32_t decimador_processar(DecimadorCic *d, const uint16_t *entrada, uint32_t num_entrada,
+                             uint32_t passo_entrada, uint16_t *saida, uint32_t passo_saida);
+
+#endif
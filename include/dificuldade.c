@@ -0,0 +1,83 @@
+#include "dificuldade.h"
+#include <string.h>
+
+void dificuldade_iniciar(Dificuldade *d, const volatile ConfigDificuldade *cfg, q16_t alvo_inicial,
+                         q16_t passo, q16_t alvo_min, q16_t alvo_max, uint64_t agora_us) {
+    memset(d, 0, sizeof(*d));
+    d->cfg = cfg;
+    d->alvo = q16_limitar(alvo_inicial, alvo_min, alvo_max);
+    d->passo = passo;
+    d->alvo_min = alvo_min;
+    d->alvo_max = alvo_max;
+    d->inicio_segundo_us = agora_us;
+}
+
+// Taxa de sucesso na janela, em %
+uint8_t dificuldade_taxa_sucesso(const Dificuldade *d) {
+    if (d->cheios == 0) return 0;
+    return (uint8_t)(d->soma_no_alvo_ms / (10u * d->cheios));
+}
+
+// Percentil p (%) das médias da janela, por ordenação de uma cópia
+static q16_t percentil_janela(const Dificuldade *d, uint32_t p) {
+    q16_t v[DIFICULDADE_JANELA_S];
+    uint32_t n = d->cheios;
+    for (uint32_t i = 0; i < n; i++) {
+        q16_t x = d->medias[i];
+        uint32_t j = i;
+        for (; j > 0 && q16_comparar(v[j - 1], x) > 0; j--) v[j] = v[j - 1];
+        v[j] = x;
+    }
+    if (p > 100) p = 100;
+    return v[(p * (n - 1) + 50) / 100];
+}
+
+// Fecha o segundo em aberto: entra na janela e reajusta o alvo
+static void fechar_segundo(Dificuldade *d, uint8_t nivel) {
+    uint32_t no_alvo_ms = d->no_alvo_us / 1000;
+    if (no_alvo_ms > 1000) no_alvo_ms = 1000;
+
+    if (d->cheios == DIFICULDADE_JANELA_S) {
+        d->soma_no_alvo_ms -= d->no_alvo_ms[d->pos];
+    } else {
+        d->cheios++;
+    }
+    d->medias[d->pos] = Q16_BRUTO(d->soma / (int64_t)d->amostras);
+    d->no_alvo_ms[d->pos] = (uint16_t)no_alvo_ms;
+    d->soma_no_alvo_ms += no_alvo_ms;
+    d->pos = (uint8_t)((d->pos + 1) % DIFICULDADE_JANELA_S);
+
+    d->soma = 0;
+    d->amostras = 0;
+    d->no_alvo_us = 0;
+
+    if (d->cheios < DIFICULDADE_SEGUNDOS_MIN) return;
+
+    const volatile ConfigDificuldade *cfg = d->cfg;
+    uint32_t p = cfg->percentil_base + (uint32_t)(nivel > 0 ? nivel - 1 : 0) * cfg->percentil_por_nivel;
+    q16_t referencia = percentil_janela(d, p);
+    d->alvo = q16_somar(d->alvo, q16_escalar(q16_subtrair(referencia, d->alvo), 1, 4));
+
+    uint8_t taxa = dificuldade_taxa_sucesso(d);
+    if (taxa > cfg->sucesso_max) {
+        d->alvo = q16_somar(d->alvo, d->passo);
+    } else if (taxa < cfg->sucesso_min) {
+        d->alvo = q16_subtrair(d->alvo, d->passo);
+    }
+    d->alvo = q16_limitar(d->alvo, d->alvo_min, d->alvo_max);
+}
+
+// Registra o valor atual e o intervalo de aquisição avaliado (no alvo ou
+// não); retorna true quando um segundo fechou e o alvo foi reajustado
+bool dificuldade_registrar(Dificuldade *d, q16_t valor, uint64_t intervalo_us, bool no_alvo,
+                           uint64_t agora_us, uint8_t nivel) {
+    d->soma += valor.bruto;
+    d->amostras++;
+    if (no_alvo) d->no_alvo_us += (uint32_t)intervalo_us;
+
+    if (agora_us - d->inicio_segundo_us < 1000000u) return false;
+    d->inicio_segundo_us += 1000000u;
+    if (agora_us - d->inicio_segundo_us >= 1000000u) d->inicio_segundo_us = agora_us;   // Lacuna
+    fechar_segundo(d, nivel);
+    return true;
+}
@@ -0,0 +1,52 @@
+#ifndef DIFICULDADE_H
+#define DIFICULDADE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fixo.h"
+
+// Dificuldade adaptativa de um sinal de treino. A cada segundo de aquisição
+// o alvo se aproxima do percentil das médias por segundo da janela recente
+// (o percentil sobe com o nível) e é corrigido por um passo quando a taxa
+// de sucesso (tempo no alvo na janela) sai da faixa configurada. Janela e
+// taxa são mantidas de forma incremental; o percentil ordena no máximo
+// DIFICULDADE_JANELA_S valores uma vez por segundo. Não depende do SDK.
+#define DIFICULDADE_JANELA_S 30
+#define DIFICULDADE_SEGUNDOS_MIN 5      // Segundos na janela antes de adaptar
+
+// Parâmetros compartilhados pelos sinais, editáveis no modo de configuração
+typedef struct {
+    uint8_t percentil_base;         // Percentil da janela no nível 1 (%)
+    uint8_t percentil_por_nivel;    // Acréscimo por nível (%)
+    uint8_t sucesso_min;            // Faixa da taxa de sucesso (% do tempo no alvo)
+    uint8_t sucesso_max;
+} ConfigDificuldade;
+
+typedef struct {
+    const volatile ConfigDificuldade *cfg;
+    q16_t alvo;
+    q16_t passo;                    // Correção por segundo fora da faixa
+    q16_t alvo_min;
+    q16_t alvo_max;
+
+    // Janela: média e tempo no alvo de cada segundo
+    q16_t medias[DIFICULDADE_JANELA_S];
+    uint16_t no_alvo_ms[DIFICULDADE_JANELA_S];
+    uint8_t pos;
+    uint8_t cheios;
+    uint32_t soma_no_alvo_ms;
+
+    // Segundo em aberto
+    uint64_t inicio_segundo_us;
+    int64_t soma;
+    uint32_t amostras;
+    uint32_t no_alvo_us;
+} Dificuldade;
+
+void dificuldade_iniciar(Dificuldade *d, const volatile ConfigDificuldade *cfg, q16_t alvo_inicial,
+                         q16_t passo, q16_t alvo_min, q16_t alvo_max, uint64_t agora_us);
+bool dificuldade_registrar(Dificuldade *d, q16_t valor, uint64_t intervalo_us, bool no_alvo,
+                           uint64_t agora_us, uint8_t nivel);
+uint8_t dificuldade_taxa_sucesso(const Dificuldade *d);
+
+#endif
@@ -0,0 +1,186 @@
+#include "espectro.h"
+#include <math.h>
+#include <string.h>
+
+// FFT complexa de N/2 pontos; a parte real do sinal vai nos índices pares e a
+// imaginária nos ímpares, e a separação final recupera o espectro real de N pontos.
+#define M (ESPECTRO_N / 2)
+#define M_LOG2 (ESPECTRO_N_LOG2 - 1)
+
+// Margem para as somas da FFT e da separação não estourarem 16 bits
+#define PICO_ENTRADA (1 << 13)
+
+typedef struct {
+    int16_t re;
+    int16_t im;
+} ComplexoQ15;
+
+// Limites das bandas em centésimos de Hz [início, fim)
+static const uint16_t limites_banda[ESPECTRO_NUM_BANDAS][2] = {
+    [BANDA_DELTA] = {50, 400},
+    [BANDA_THETA] = {400, 800},
+    [BANDA_ALPHA] = {800, 1200},
+    [BANDA_BETA]  = {1200, 3000},
+};
+
+// Tabelas calculadas uma vez na inicialização
+static int16_t janela[ESPECTRO_N];          // Hann, Q15
+static int16_t cosseno[M];                  // cos(2*pi*k/N), Q15
+static int16_t seno[M];                     // sin(2*pi*k/N), Q15
+static uint8_t bin_inicio[ESPECTRO_NUM_BANDAS];
+static uint8_t bin_fim[ESPECTRO_NUM_BANDAS];
+
+static ComplexoQ15 z[M];
+
+static inline int16_t mul_q15(int16_t a, int16_t b) {
+    return (int16_t)(((int32_t)a * b) >> 15);
+}
+
+static int16_t para_q15(double v) {
+    long q = lround(v * 32768.0);
+    if (q > 32767) q = 32767;
+    if (q < -32768) q = -32768;
+    return (int16_t)q;
+}
+
+void espectro_init(uint32_t taxa_amostragem_hz) {
+    for (uint32_t n = 0; n < ESPECTRO_N; n++) {
+        janela[n] = para_q15(0.5 - 0.5 * cos(2.0 * M_PI * n / ESPECTRO_N));
+    }
+    for (uint32_t k = 0; k < M; k++) {
+        cosseno[k] = para_q15(cos(2.0 * M_PI * k / ESPECTRO_N));
+        seno[k] = para_q15(sin(2.0 * M_PI * k / ESPECTRO_N));
+    }
+
+    // Bin k cobre a frequência k * taxa / N; a banda inclui os bins com
+    // frequência dentro de [início, fim)
+    for (int b = 0; b < ESPECTRO_NUM_BANDAS; b++) {
+        uint32_t ini = (limites_banda[b][0] * ESPECTRO_N + taxa_amostragem_hz * 100 - 1) / (taxa_amostragem_hz * 100);
+        uint32_t fim = (limites_banda[b][1] * ESPECTRO_N + taxa_amostragem_hz * 100 - 1) / (taxa_amostragem_hz * 100);
+        if (ini < 1) ini = 1;
+        if (fim > M) fim = M;
+        bin_inicio[b] = (uint8_t)ini;
+        bin_fim[b] = (uint8_t)fim;
+    }
+}
+
+void espectro_canal_init(Espectro *e) {
+    memset(e, 0, sizeof(*e));
+}
+
+// Acumula uma amostra; retorna true quando há um bloco completo para calcular
+bool espectro_adicionar(Espectro *e, int32_t amostra) {
+    if (e->num_amostras < ESPECTRO_N) {
+        e->amostras[e->num_amostras++] = amostra;
+    }
+    return e->num_amostras == ESPECTRO_N;
+}
+
+// FFT radix-2 DIT in-place com divisão por 2 em cada estágio (sem estouro)
+static void fft_complexa(ComplexoQ15 *x) {
+    // Permutação por inversão de bits
+    for (uint32_t i = 1, j = 0; i < M; i++) {
+        uint32_t bit = M >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j |= bit;
+        if (i < j) {
+            ComplexoQ15 t = x[i];
+            x[i] = x[j];
+            x[j] = t;
+        }
+    }
+
+    for (uint32_t tam = 2; tam <= M; tam <<= 1) {
+        uint32_t meio = tam >> 1;
+        uint32_t passo = (ESPECTRO_N / tam);   // Índice na tabela de N pontos
+        for (uint32_t ini = 0; ini < M; ini += tam) {
+            for (uint32_t k = 0; k < meio; k++) {
+                int16_t c = cosseno[k * passo];
+                int16_t s = seno[k * passo];
+                ComplexoQ15 *a = &x[ini + k];
+                ComplexoQ15 *b = &x[ini + k + meio];
+                // t = b * e^(-j*theta)
+                int32_t tr = ((int32_t)b->re * c + (int32_t)b->im * s) >> 15;
+                int32_t ti = ((int32_t)b->im * c - (int32_t)b->re * s) >> 15;
+                int32_t ar = a->re;
+                int32_t ai = a->im;
+                a->re = (int16_t)((ar + tr) >> 1);
+                a->im = (int16_t)((ai + ti) >> 1);
+                b->re = (int16_t)((ar - tr) >> 1);
+                b->im = (int16_t)((ai - ti) >> 1);
+            }
+        }
+    }
+}
+
+static inline uint32_t modulo_quadrado(int32_t re, int32_t im) {
+    return (uint32_t)(re * re) + (uint32_t)(im * im);
+}
+
+// Janela, normaliza e transforma o bloco atual, soma a potência por banda e
+// descarta a metade mais antiga (sobreposição de 50%).
+void espectro_calcular(Espectro *e, ResultadoBandas *resultado) {
+    // Remove o nível DC do bloco
+    int64_t soma = 0;
+    for (uint32_t n = 0; n < ESPECTRO_N; n++) soma += e->amostras[n];
+    int32_t media = (int32_t)(soma / ESPECTRO_N);
+
+    int32_t pico = 1;
+    for (uint32_t n = 0; n < ESPECTRO_N; n++) {
+        int32_t v = e->amostras[n] - media;
+        if (v < 0) v = -v;
+        if (v > pico) pico = v;
+    }
+
+    // Escala em potência de 2 para que o pico fique próximo de PICO_ENTRADA
+    int deslocamento = 0;
+    while ((pico << 1) <= PICO_ENTRADA && deslocamento < 16) { pico <<= 1; deslocamento++; }
+    while (pico > PICO_ENTRADA) { pico >>= 1; deslocamento--; }
+
+    for (uint32_t n = 0; n < M; n++) {
+        int32_t par = e->amostras[2 * n] - media;
+        int32_t impar = e->amostras[2 * n + 1] - media;
+        par = deslocamento >= 0 ? par << deslocamento : par >> -deslocamento;
+        impar = deslocamento >= 0 ? impar << deslocamento : impar >> -deslocamento;
+        z[n].re = mul_q15((int16_t)par, janela[2 * n]);
+        z[n].im = mul_q15((int16_t)impar, janela[2 * n + 1]);
+    }
+
+    fft_complexa(z);
+
+    // Separação: X[k] = E[k] + W^k * O[k], com E e O vindos de Z[k] e Z[M-k]*
+    uint64_t potencia_banda[ESPECTRO_NUM_BANDAS] = {0};
+    for (uint32_t k = 1; k < M; k++) {
+        const ComplexoQ15 *zk = &z[k];
+        const ComplexoQ15 *zm = &z[M - k];
+        int32_t er = (zk->re + zm->re) >> 1;
+        int32_t ei = (zk->im - zm->im) >> 1;
+        int32_t or_ = (zk->im + zm->im) >> 1;
+        int32_t oi = (zm->re - zk->re) >> 1;
+        int32_t c = cosseno[k];
+        int32_t s = seno[k];
+        int32_t xr = er + ((c * or_ + s * oi) >> 15);
+        int32_t xi = ei + ((c * oi - s * or_) >> 15);
+        uint32_t p = modulo_quadrado(xr, xi);
+
+        for (int b = 0; b < ESPECTRO_NUM_BANDAS; b++) {
+            if (k >= bin_inicio[b] && k < bin_fim[b]) {
+                potencia_banda[b] += p;
+            }
+        }
+    }
+
+    uint64_t total = 0;
+    for (int b = 0; b < ESPECTRO_NUM_BANDAS; b++) {
+        resultado->potencia[b] = potencia_banda[b];
+        total += potencia_banda[b];
+    }
+    for (int b = 0; b < ESPECTRO_NUM_BANDAS; b++) {
+        resultado->relativa[b] = total ? (uint16_t)((resultado->potencia[b] * 1000) / total) : 0;
+    }
+    // Potência real = potência * 4^(estágios - deslocamento)
+    resultado->expoente = (int8_t)(M_LOG2 - deslocamento);
+
+    memmove(e->amostras, &e->amostras[ESPECTRO_SALTO], (ESPECTRO_N - ESPECTRO_SALTO) * sizeof(int32_t));
+    e->num_amostras = ESPECTRO_N - ESPECTRO_SALTO;
+}
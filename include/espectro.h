@@ -0,0 +1,37 @@
+#ifndef ESPECTRO_H
+#define ESPECTRO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// FFT real de ponto fixo (Q15) sobre blocos janelados (Hann) com 50% de
+// sobreposição. Não depende do SDK do Pico: compila também no host.
+#define ESPECTRO_N_LOG2 8
+#define ESPECTRO_N (1u << ESPECTRO_N_LOG2)       // Amostras por bloco
+#define ESPECTRO_SALTO (ESPECTRO_N / 2)          // Novas amostras entre blocos
+
+typedef enum {
+    BANDA_DELTA = 0,   // 0.5-4 Hz
+    BANDA_THETA,       // 4-8 Hz
+    BANDA_ALPHA,       // 8-12 Hz
+    BANDA_BETA,        // 12-30 Hz
+    ESPECTRO_NUM_BANDAS
+} BandaEeg;
+
+typedef struct {
+    int32_t amostras[ESPECTRO_N];
+    uint32_t num_amostras;
+} Espectro;
+
+typedef struct {
+    uint64_t potencia[ESPECTRO_NUM_BANDAS];     // Escala relativa ao bloco (entrada normalizada)
+    uint16_t relativa[ESPECTRO_NUM_BANDAS];     // Fração da potência total, em décimos de %
+    int8_t expoente;                            // Potência real = potencia * 4^expoente
+} ResultadoBandas;
+
+void espectro_init(uint32_t taxa_amostragem_hz);
+void espectro_canal_init(Espectro *e);
+bool espectro_adicionar(Espectro *e, int32_t amostra);
+void espectro_calcular(Espectro *e, ResultadoBandas *resultado);
+
+#endif
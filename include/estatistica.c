@@ -0,0 +1,54 @@
+#include "estatistica.h"
+#include <string.h>
+
+void estatistica_zerar(EstatisticaOnline *e) {
+    memset(e, 0, sizeof(*e));
+}
+
+// Welford com a média exata: M2 += (x - média anterior) * (x - média nova)
+void estatistica_adicionar(EstatisticaOnline *e, q16_t x) {
+    if (e->amostras == 0) {
+        e->minimo = x;
+        e->maximo = x;
+    } else {
+        e->minimo = q16_min(e->minimo, x);
+        e->maximo = q16_max(e->maximo, x);
+    }
+
+    q16_t anterior = e->media;
+    e->amostras++;
+    e->soma += x.bruto;
+    e->media = Q16_BRUTO(e->soma / (int64_t)e->amostras);
+    e->m2 += ((int64_t)q16_subtrair(x, anterior).bruto * q16_subtrair(x, e->media).bruto) >> Q16_FRAC;
+}
+
+// Variância amostral (n - 1), Q16.16
+q16_t estatistica_variancia(const EstatisticaOnline *e) {
+    if (e->amostras < 2) return Q16_ZERO;
+    int64_t v = e->m2 / (int64_t)(e->amostras - 1);
+    return Q16_BRUTO(v > INT32_MAX ? INT32_MAX : v);
+}
+
+// Raiz inteira de 64 bits, bit a bit
+static uint32_t raiz_inteira(uint64_t v) {
+    uint64_t resultado = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > v) bit >>= 2;
+    while (bit) {
+        if (v >= resultado + bit) {
+            v -= resultado + bit;
+            resultado = (resultado >> 1) + bit;
+        } else {
+            resultado >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)resultado;
+}
+
+// Desvio padrão, Q16.16: sqrt(var * 2^16) mantém a escala
+q16_t estatistica_desvio(const EstatisticaOnline *e) {
+    q16_t var = estatistica_variancia(e);
+    if (var.bruto <= 0) return Q16_ZERO;
+    return Q16_BRUTO(raiz_inteira((uint64_t)var.bruto << Q16_FRAC));
+}
@@ -0,0 +1,26 @@
+#ifndef ESTATISTICA_H
+#define ESTATISTICA_H
+
+#include <stdint.h>
+#include "fixo.h"
+
+// Estatística online de uma série Q16.16 em O(1) por amostra: soma exata em
+// 64 bits (a média é sempre soma / n, sem deriva), variância por Welford
+// com M2 em Q16.16 de 64 bits, mínimo e máximo. Com valores até 100 a soma
+// e M2 só estouram depois de bilhões de amostras, muito além de dias de
+// sessão a 20 Hz. Não depende do SDK.
+typedef struct {
+    uint32_t amostras;
+    int64_t soma;       // Soma exata dos valores Q16.16
+    q16_t media;        // soma / amostras, atualizada a cada amostra
+    int64_t m2;         // Soma dos quadrados dos desvios, Q16.16
+    q16_t minimo;
+    q16_t maximo;
+} EstatisticaOnline;
+
+void estatistica_zerar(EstatisticaOnline *e);
+void estatistica_adicionar(EstatisticaOnline *e, q16_t x);
+q16_t estatistica_variancia(const EstatisticaOnline *e);
+q16_t estatistica_desvio(const EstatisticaOnline *e);
+
+#endif
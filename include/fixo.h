@@ -0,0 +1,93 @@
+#ifndef FIXO_H
+#define FIXO_H
+
+#include <stdint.h>
+
+// Ponto fixo Q16.16 para os níveis, ondas, limiares e estatísticas. O RP2040
+// não tem FPU: com este tipo a classificação e as estatísticas usam só
+// aritmética inteira, e a conversão para float fica restrita à exibição.
+//
+// O valor fica numa struct de um membro para o compilador recusar misturas
+// com inteiros comuns (somar uma porcentagem inteira, comparar com um número
+// de amostras): toda operação passa pelas funções abaixo, e o campo bruto só
+// é lido direto nos acumuladores de 64 bits e nas conversões de formato. Uma
+// struct de 4 bytes vai e volta em registrador no AAPCS, então o custo é o
+// mesmo do int32_t.
+typedef struct {
+    int32_t bruto;
+} q16_t;
+
+#define Q16_FRAC 16
+
+// Constantes: Q16_INT para inteiros, Q16_CONST para literais fracionários
+// (avaliado em tempo de compilação), Q16_BRUTO para o valor já em Q16.16
+#define Q16_BRUTO(b) ((q16_t){(int32_t)(b)})
+#define Q16_INT(n) Q16_BRUTO((n) * ((int32_t)1 << Q16_FRAC))
+#define Q16_CONST(x) Q16_BRUTO((x) * 65536.0 + ((x) >= 0 ? 0.5 : -0.5))
+#define Q16_ZERO Q16_BRUTO(0)
+#define Q16_UM Q16_INT(1)
+
+static inline q16_t q16_de_int(int32_t n) {
+    return Q16_BRUTO(n * ((int32_t)1 << Q16_FRAC));
+}
+
+// Parte inteira (arredondada para baixo)
+static inline int32_t q16_para_int(q16_t v) {
+    return v.bruto >> Q16_FRAC;
+}
+
+static inline q16_t q16_somar(q16_t a, q16_t b) {
+    return Q16_BRUTO(a.bruto + b.bruto);
+}
+
+static inline q16_t q16_subtrair(q16_t a, q16_t b) {
+    return Q16_BRUTO(a.bruto - b.bruto);
+}
+
+static inline q16_t q16_negar(q16_t v) {
+    return Q16_BRUTO(-v.bruto);
+}
+
+static inline q16_t q16_mul(q16_t a, q16_t b) {
+    return Q16_BRUTO(((int64_t)a.bruto * b.bruto) >> Q16_FRAC);
+}
+
+// a / b em Q16 (b != 0)
+static inline q16_t q16_div(q16_t a, q16_t b) {
+    return Q16_BRUTO(((int64_t)a.bruto << Q16_FRAC) / b.bruto);
+}
+
+// v * num / den com intermediário de 64 bits (den != 0)
+static inline q16_t q16_escalar(q16_t v, int32_t num, int32_t den) {
+    return Q16_BRUTO((int64_t)v.bruto * num / den);
+}
+
+// Razão num/den em Q16 (den > 0)
+static inline q16_t q16_fracao(int32_t num, int32_t den) {
+    return Q16_BRUTO(((int64_t)num << Q16_FRAC) / den);
+}
+
+static inline int q16_comparar(q16_t a, q16_t b) {
+    return (a.bruto > b.bruto) - (a.bruto < b.bruto);
+}
+
+static inline q16_t q16_min(q16_t a, q16_t b) {
+    return a.bruto < b.bruto ? a : b;
+}
+
+static inline q16_t q16_max(q16_t a, q16_t b) {
+    return a.bruto > b.bruto ? a : b;
+}
+
+static inline q16_t q16_limitar(q16_t v, q16_t min, q16_t max) {
+    if (v.bruto < min.bruto) return min;
+    if (v.bruto > max.bruto) return max;
+    return v;
+}
+
+// Somente para exibição e telemetria
+static inline float q16_para_float(q16_t v) {
+    return (float)v.bruto * (1.0f / 65536.0f);
+}
+
+#endif
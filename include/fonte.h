@@ -0,0 +1,41 @@
+#ifndef FONTE_H
+#define FONTE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "anel_quadros.h"
+#include "calibracao.h"
+
+// Fonte de canais: interface comum aos dispositivos de aquisição (ADC
+// interno com potenciômetros, front-end ADS1299 via SPI, dispositivo
+// simulado). Cada fonte publica quadros multicanal no seu anel, e o
+// pipeline os consome sem saber a origem.
+#define FONTE_MAX_CANAIS ANEL_MAX_CANAIS
+
+// Capacidade dos anéis das fontes (quadros) e quadros processados por vez
+#define FONTE_CAPACIDADE_ANEL 256
+#define FONTE_QUADROS_BLOCO 32
+
+#if FONTE_CAPACIDADE_ANEL % FONTE_QUADROS_BLOCO != 0
+#error "FONTE_CAPACIDADE_ANEL deve ser múltiplo de FONTE_QUADROS_BLOCO"
+#endif
+
+typedef struct {
+    const char *nome;
+    uint8_t num_canais;
+    uint32_t taxa_hz;       // Quadros por segundo
+    int32_t minimo;         // Faixa das amostras entregues
+    int32_t maximo;
+    AnelQuadros *anel;      // Quadros produzidos pela fonte
+
+    void (*iniciar)(void);
+
+    // Opcional: fontes sem interrupção própria produzem os quadros aqui,
+    // chamada pelo consumidor antes de ler o anel
+    void (*produzir)(void);
+
+    // Opcional: NULL se a fonte não aceita tabelas de calibração
+    void (*definir_calibracao)(unsigned canal, const CalibracaoCanal *calibracao);
+} FonteCanais;
+
+#endif
@@ -0,0 +1,95 @@
+#include "fonte_simulada.h"
+#include "gerador_eeg.h"
+#include <stddef.h>
+
+// Amplitudes por banda (delta, theta, alpha, beta); canais ímpares têm alpha
+// dominante para diferenciar as derivações
+static const uint16_t amplitudes_par[ESPECTRO_NUM_BANDAS] = {800, 600, 700, 500};
+static const uint16_t amplitudes_impar[ESPECTRO_NUM_BANDAS] = {600, 400, 1500, 300};
+
+static GeradorEeg geradores[FONTE_MAX_CANAIS];
+static RelogioUs relogio;
+static uint64_t inicio_us;
+static uint32_t periodo_us;
+static uint32_t blocos_gerados = 0;
+static FonteCanais fonte;
+
+// Bloco gerado antes da publicação e anel entregue ao consumidor
+static int32_t bloco[FONTE_QUADROS_BLOCO][FONTE_MAX_CANAIS];
+static QuadroAmostras quadros[FONTE_CAPACIDADE_ANEL];
+static AnelQuadros anel;
+
+static void fonte_simulada_iniciar(void) {
+    anel_init(&anel, quadros, FONTE_CAPACIDADE_ANEL);
+    inicio_us = relogio();
+    blocos_gerados = 0;
+}
+
+// Gera e publica os blocos cujo fim o relógio já passou. Blocos vencidos há
+// mais que a capacidade do anel nem são gerados: contam direto como
+// estouro, como aconteceria num dispositivo real com o consumidor parado.
+static void fonte_simulada_produzir(void) {
+    uint64_t decorrido = relogio() - inicio_us;
+    uint32_t devidos = (uint32_t)(decorrido / ((uint64_t)periodo_us * FONTE_QUADROS_BLOCO));
+    const uint32_t max_blocos = FONTE_CAPACIDADE_ANEL / FONTE_QUADROS_BLOCO;
+
+    if (devidos - blocos_gerados > max_blocos) {
+        uint32_t novo_inicio = devidos - max_blocos;
+        anel.estouros += (novo_inicio - blocos_gerados) * FONTE_QUADROS_BLOCO;
+        blocos_gerados = novo_inicio;
+    }
+
+    for (; blocos_gerados < devidos; blocos_gerados++) {
+        for (uint8_t c = 0; c < fonte.num_canais; c++) {
+            gerador_eeg_gerar(&geradores[c], &bloco[0][c], FONTE_QUADROS_BLOCO, FONTE_MAX_CANAIS);
+        }
+
+        uint64_t instante_us = inicio_us + (uint64_t)blocos_gerados * FONTE_QUADROS_BLOCO * periodo_us;
+        for (uint32_t i = 0; i < FONTE_QUADROS_BLOCO; i++, instante_us += periodo_us) {
+            QuadroAmostras *q = anel_reservar(&anel);
+            if (!q) continue;
+            q->instante_us = instante_us;
+            for (uint8_t c = 0; c < fonte.num_canais; c++) {
+                int32_t v = bloco[i][c];
+                if (v < 0) v = 0;
+                if (v > FONTE_SIMULADA_FUNDO_ESCALA) v = FONTE_SIMULADA_FUNDO_ESCALA;
+                q->canais[c] = v;
+            }
+            anel_publicar(&anel);
+        }
+    }
+}
+
+// Prepara a fonte; taxa e número de canais são limitados às faixas suportadas
+const FonteCanais *fonte_simulada_configurar(uint8_t num_canais, uint32_t taxa_hz,
+                                             uint32_t semente, RelogioUs relogio_us) {
+    if (num_canais < 1) num_canais = 1;
+    if (num_canais > FONTE_MAX_CANAIS) num_canais = FONTE_MAX_CANAIS;
+    if (taxa_hz < FONTE_SIMULADA_TAXA_MIN) taxa_hz = FONTE_SIMULADA_TAXA_MIN;
+    if (taxa_hz > FONTE_SIMULADA_TAXA_MAX) taxa_hz = FONTE_SIMULADA_TAXA_MAX;
+
+    relogio = relogio_us;
+    periodo_us = 1000000u / taxa_hz;
+
+    for (uint8_t c = 0; c < num_canais; c++) {
+        const uint16_t *amplitudes = (c & 1) ? amplitudes_impar : amplitudes_par;
+        gerador_eeg_init(&geradores[c], taxa_hz, FONTE_SIMULADA_FUNDO_ESCALA / 2, semente + c);
+        for (int b = 0; b < ESPECTRO_NUM_BANDAS; b++) {
+            gerador_eeg_definir_amplitude(&geradores[c], (BandaEeg)b, amplitudes[b]);
+        }
+        gerador_eeg_definir_ruido(&geradores[c], 300);
+    }
+
+    fonte = (FonteCanais){
+        .nome = "Simulada",
+        .num_canais = num_canais,
+        .taxa_hz = taxa_hz,
+        .minimo = 0,
+        .maximo = FONTE_SIMULADA_FUNDO_ESCALA,
+        .anel = &anel,
+        .iniciar = fonte_simulada_iniciar,
+        .produzir = fonte_simulada_produzir,
+        .definir_calibracao = NULL,
+    };
+    return &fonte;
+}
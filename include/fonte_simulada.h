@@ -0,0 +1,19 @@
+#ifndef FONTE_SIMULADA_H
+#define FONTE_SIMULADA_H
+
+#include <stdint.h>
+#include "fonte.h"
+
+// Dispositivo simulado: cada canal é um gerador de EEG sintético com semente
+// própria, entregue no ritmo de um relógio externo (time_us_64 no Pico, ou um
+// relógio de teste no host). Não depende do SDK.
+#define FONTE_SIMULADA_TAXA_MIN 250
+#define FONTE_SIMULADA_TAXA_MAX 1000
+#define FONTE_SIMULADA_FUNDO_ESCALA 65520
+
+typedef uint64_t (*RelogioUs)(void);
+
+const FonteCanais *fonte_simulada_configurar(uint8_t num_canais, uint32_t taxa_hz,
+                                             uint32_t semente, RelogioUs relogio);
+
+#endif
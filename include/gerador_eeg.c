@@ -0,0 +1,116 @@
+#include "gerador_eeg.h"
+#include <string.h>
+
+#define TABELA_LOG2 8
+
+// Seno de 256 pontos em Q15 (flash)
+static const int16_t tabela_seno[1u << TABELA_LOG2] = {
+         0,    804,   1608,   2410,   3212,   4011,   4808,   5602,   6393,   7179,   7962,   8739,   9512,  10278,  11039,  11793,
+     12539,  13279,  14010,  14732,  15446,  16151,  16846,  17530,  18204,  18868,  19519,  20159,  20787,  21403,  22005,  22594,
+     23170,  23731,  24279,  24811,  25329,  25832,  26319,  26790,  27245,  27683,  28105,  28510,  28898,  29268,  29621,  29956,
+     30273,  30571,  30852,  31113,  31356,  31580,  31785,  31971,  32137,  32285,  32412,  32521,  32609,  32678,  32728,  32757,
+     32767,  32757,  32728,  32678,  32609,  32521,  32412,  32285,  32137,  31971,  31785,  31580,  31356,  31113,  30852,  30571,
+     30273,  29956,  29621,  29268,  28898,  28510,  28105,  27683,  27245,  26790,  26319,  25832,  25329,  24811,  24279,  23731,
+     23170,  22594,  22005,  21403,  20787,  20159,  19519,  18868,  18204,  17530,  16846,  16151,  15446,  14732,  14010,  13279,
+     12539,  11793,  11039,  10278,   9512,   8739,   7962,   7179,   6393,   5602,   4808,   4011,   3212,   2410,   1608,    804,
+         0,   -804,  -1608,  -2410,  -3212,  -4011,  -4808,  -5602,  -6393,  -7179,  -7962,  -8739,  -9512, -10278, -11039, -11793,
+    -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530, -18204, -18868, -19519, -20159, -20787, -21403, -22005, -22594,
+    -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790, -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956,
+    -30273, -30571, -30852, -31113, -31356, -31580, -31785, -31971, -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+    -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285, -32137, -31971, -31785, -31580, -31356, -31113, -30852, -30571,
+    -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683, -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731,
+    -23170, -22594, -22005, -21403, -20787, -20159, -19519, -18868, -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+    -12539, -11793, -11039, -10278,  -9512,  -8739,  -7962,  -7179,  -6393,  -5602,  -4808,  -4011,  -3212,  -2410,  -1608,   -804
+};
+
+// Faixas de passeio dos osciladores em centésimos de Hz (dentro de cada banda)
+static const uint16_t faixa_banda[ESPECTRO_NUM_BANDAS][2] = {
+    [BANDA_DELTA] = {100, 350},
+    [BANDA_THETA] = {450, 750},
+    [BANDA_ALPHA] = {850, 1150},
+    [BANDA_BETA]  = {1300, 2800},
+};
+
+static uint32_t calcular_incremento(uint32_t freq_chz, uint32_t taxa_hz) {
+    return (uint32_t)(((uint64_t)freq_chz << 32) / (taxa_hz * 100u));
+}
+
+void gerador_eeg_init(GeradorEeg *g, uint32_t taxa_hz, int32_t nivel_dc, uint32_t semente) {
+    memset(g, 0, sizeof(*g));
+    g->taxa_hz = taxa_hz;
+    g->nivel_dc = nivel_dc;
+    prng_semear(&g->prng, semente);
+
+    for (int b = 0; b < ESPECTRO_NUM_BANDAS; b++) {
+        uint32_t largura = faixa_banda[b][1] - faixa_banda[b][0];
+        for (int i = 0; i < GERADOR_OSCILADORES_BANDA; i++) {
+            Oscilador *o = &g->osc[b][i];
+            o->freq_chz = faixa_banda[b][0] + (largura * (2 * i + 1)) / (2 * GERADOR_OSCILADORES_BANDA);
+            o->incremento = calcular_incremento(o->freq_chz, taxa_hz);
+            o->fase = prng_proximo(&g->prng);
+        }
+    }
+}
+
+void gerador_eeg_definir_amplitude(GeradorEeg *g, BandaEeg banda, uint16_t amplitude) {
+    if (amplitude > GERADOR_AMPLITUDE_MAX) amplitude = GERADOR_AMPLITUDE_MAX;
+    if (banda < ESPECTRO_NUM_BANDAS) g->amplitude[banda] = amplitude;
+}
+
+void gerador_eeg_definir_ruido(GeradorEeg *g, uint16_t amplitude) {
+    if (amplitude > GERADOR_AMPLITUDE_MAX) amplitude = GERADOR_AMPLITUDE_MAX;
+    g->amplitude_ruido = amplitude;
+}
+
+// Passeio aleatório da frequência (uma vez por bloco), preso à faixa da banda
+static void variar_frequencias(GeradorEeg *g) {
+    for (int b = 0; b < ESPECTRO_NUM_BANDAS; b++) {
+        int32_t passo = (faixa_banda[b][1] - faixa_banda[b][0]) / 20;
+        for (int i = 0; i < GERADOR_OSCILADORES_BANDA; i++) {
+            Oscilador *o = &g->osc[b][i];
+            int32_t f = o->freq_chz + ((prng_uniforme_q15(&g->prng) * passo) >> 15);
+            if (f < faixa_banda[b][0]) f = faixa_banda[b][0];
+            if (f > faixa_banda[b][1]) f = faixa_banda[b][1];
+            o->freq_chz = (uint16_t)f;
+            o->incremento = calcular_incremento(o->freq_chz, g->taxa_hz);
+        }
+    }
+}
+
+// Ruído rosa (Voss-McCartney): a linha k é sorteada de novo a cada 2^k
+// amostras, e a soma das linhas aproxima um espectro 1/f
+static inline int32_t ruido_rosa(GeradorEeg *g) {
+    uint32_t n = ++g->contador;
+    int k = 0;
+    while (k < GERADOR_LINHAS_RUIDO - 1 && (n & 1u) == 0) {
+        n >>= 1;
+        k++;
+    }
+    int32_t novo = prng_uniforme_q15(&g->prng);
+    g->soma_ruido += novo - g->linhas_ruido[k];
+    g->linhas_ruido[k] = novo;
+    return g->soma_ruido / GERADOR_LINHAS_RUIDO;
+}
+
+// Gera um bloco de amostras na mesma escala da aquisição (DC + sinal),
+// para entrar no pipeline no lugar de um canal real
+void gerador_eeg_gerar(GeradorEeg *g, int32_t *saida, uint32_t num, uint32_t passo) {
+    variar_frequencias(g);
+
+    for (uint32_t n = 0; n < num; n++) {
+        int32_t acc = 0;
+        for (int b = 0; b < ESPECTRO_NUM_BANDAS; b++) {
+            int32_t soma_banda = 0;
+            for (int i = 0; i < GERADOR_OSCILADORES_BANDA; i++) {
+                Oscilador *o = &g->osc[b][i];
+                soma_banda += tabela_seno[o->fase >> (32 - TABELA_LOG2)];
+                o->fase += o->incremento;
+            }
+            acc += (soma_banda * g->amplitude[b]) >> 15;
+        }
+        acc += (ruido_rosa(g) * g->amplitude_ruido) >> 15;
+
+        *saida = g->nivel_dc + acc;
+        saida += passo;
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef GERADOR_EEG_H
+#define GERADOR_EEG_H
+
+#include <stdint.h>
+#include "espectro.h"
+#include "prng.h"
+
+// Gerador de EEG sintético: por banda, osciladores de tabela de onda cuja
+// frequência passeia aleatoriamente dentro da banda, somados a ruído 1/f.
+#define GERADOR_OSCILADORES_BANDA 2
+#define GERADOR_LINHAS_RUIDO 8
+
+// Amplitude máxima por oscilador (mantém a soma da banda em 32 bits)
+#define GERADOR_AMPLITUDE_MAX 16383
+
+typedef struct {
+    uint32_t fase;
+    uint32_t incremento;
+    uint16_t freq_chz;      // Frequência atual em centésimos de Hz
+} Oscilador;
+
+typedef struct {
+    Oscilador osc[ESPECTRO_NUM_BANDAS][GERADOR_OSCILADORES_BANDA];
+    uint16_t amplitude[ESPECTRO_NUM_BANDAS];   // Pico por oscilador (unidades do ADC)
+    uint16_t amplitude_ruido;
+    int32_t linhas_ruido[GERADOR_LINHAS_RUIDO];
+    int32_t soma_ruido;
+    uint32_t contador;
+    uint32_t taxa_hz;
+    int32_t nivel_dc;
+    Prng prng;
+} GeradorEeg;
+
+void gerador_eeg_init(GeradorEeg *g, uint32_t taxa_hz, int32_t nivel_dc, uint32_t semente);
+void gerador_eeg_definir_amplitude(GeradorEeg *g, BandaEeg banda, uint16_t amplitude);
+void gerador_eeg_definir_ruido(GeradorEeg *g, uint16_t amplitude);
+void gerador_eeg_gerar(GeradorEeg *g, int32_t *saida, uint32_t num, uint32_t passo);
+
+#endif
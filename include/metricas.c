@@ -0,0 +1,73 @@
+#include "metricas.h"
+#include <string.h>
+
+void metricas_init(MotorMetricas *m) {
+    memset(m, 0, sizeof(*m));
+}
+
+// Registra uma métrica; retorna o identificador ou -1 sem espaço
+int metricas_registrar(MotorMetricas *m, const char *nome, const ExpressaoMetrica *expressao, q16_t suavizacao) {
+    if (m->num_metricas >= METRICAS_MAX) return -1;
+    Metrica *metrica = &m->metricas[m->num_metricas];
+    memset(metrica, 0, sizeof(*metrica));
+    metrica->nome = nome;
+    metrica->expressao = *expressao;
+    metrica->suavizacao = q16_limitar(suavizacao, Q16_BRUTO(1), Q16_UM);
+    return m->num_metricas++;
+}
+
+// Valor repetido não suja a entrada
+void metricas_definir_entrada(MotorMetricas *m, uint8_t entrada, q16_t valor) {
+    if (entrada >= METRICAS_MAX_ENTRADAS) return;
+    uint16_t bit = (uint16_t)(1u << entrada);
+    if ((m->entradas_validas & bit) && q16_comparar(m->entradas[entrada], valor) == 0) return;
+    m->entradas[entrada] = valor;
+    m->entradas_validas |= bit;
+    m->sujas |= bit;
+}
+
+static int64_t somar(const MotorMetricas *m, uint16_t mascara) {
+    int64_t soma = 0;
+    for (uint32_t i = 0; mascara; i++, mascara >>= 1) {
+        if (mascara & 1) soma += m->entradas[i].bruto;
+    }
+    return soma;
+}
+
+// Recalcula só as métricas com alguma entrada alterada e todas as entradas
+// já definidas; retorna quantas foram recalculadas
+uint32_t metricas_avaliar(MotorMetricas *m) {
+    uint32_t avaliadas = 0;
+    for (uint32_t i = 0; i < m->num_metricas; i++) {
+        Metrica *metrica = &m->metricas[i];
+        const ExpressaoMetrica *e = &metrica->expressao;
+        uint16_t dependencias = e->numerador | e->subtraendo | e->denominador;
+        if (!(m->sujas & dependencias)) continue;
+        if ((m->entradas_validas & dependencias) != dependencias) continue;
+
+        int64_t numerador = somar(m, e->numerador) - somar(m, e->subtraendo);
+        int64_t valor;
+        if (e->denominador) {
+            int64_t denominador = somar(m, e->denominador);
+            if (denominador == 0) continue;     // Mantém o valor anterior
+            valor = (numerador << Q16_FRAC) / denominador;
+        } else {
+            valor = numerador;
+        }
+        if (valor > INT32_MAX) valor = INT32_MAX;
+        if (valor < INT32_MIN) valor = INT32_MIN;
+        metrica->bruto = Q16_BRUTO(valor);
+
+        if (!metrica->valido) {
+            metrica->valor = metrica->bruto;
+            metrica->valido = true;
+        } else {
+            metrica->valor = q16_somar(metrica->valor,
+                                      q16_mul(q16_subtrair(metrica->bruto, metrica->valor), metrica->suavizacao));
+        }
+        avaliadas++;
+    }
+    m->sujas = 0;
+    m->avaliacoes += avaliadas;
+    return avaliadas;
+}
@@ -0,0 +1,54 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fixo.h"
+
+// Métricas derivadas das potências de banda, registradas como expressões
+// (Σ numerador − Σ subtraendo) / Σ denominador sobre entradas Q16.16
+// escolhidas por máscaras de bits. Cobre razões (theta/beta), índices
+// (beta/(alpha+theta)) e assimetrias ((D−E)/(D+E)). Cada entrada nova marca
+// as métricas que dependem dela, e só essas são recalculadas; o resultado
+// passa por uma média exponencial com fator próprio. Não depende do SDK.
+#define METRICAS_MAX_ENTRADAS 16
+#define METRICAS_MAX 8
+
+typedef struct {
+    uint16_t numerador;     // Máscaras de entradas somadas
+    uint16_t subtraendo;
+    uint16_t denominador;   // 0 = sem divisão
+} ExpressaoMetrica;
+
+typedef struct {
+    const char *nome;
+    ExpressaoMetrica expressao;
+    q16_t suavizacao;       // Fator da média exponencial (Q16, 0-1; 1 = sem suavização)
+    q16_t bruto;            // Último valor calculado
+    q16_t valor;            // Valor suavizado
+    bool valido;
+} Metrica;
+
+typedef struct {
+    q16_t entradas[METRICAS_MAX_ENTRADAS];
+    uint16_t entradas_validas;
+    uint16_t sujas;         // Entradas alteradas desde a última avaliação
+    Metrica metricas[METRICAS_MAX];
+    uint8_t num_metricas;
+    uint32_t avaliacoes;    // Métricas recalculadas desde o início
+} MotorMetricas;
+
+void metricas_init(MotorMetricas *m);
+int metricas_registrar(MotorMetricas *m, const char *nome, const ExpressaoMetrica *expressao, q16_t suavizacao);
+void metricas_definir_entrada(MotorMetricas *m, uint8_t entrada, q16_t valor);
+uint32_t metricas_avaliar(MotorMetricas *m);
+
+static inline q16_t metricas_valor(const MotorMetricas *m, int id) {
+    return m->metricas[id].valor;
+}
+
+static inline bool metricas_valida(const MotorMetricas *m, int id) {
+    return id >= 0 && id < m->num_metricas && m->metricas[id].valido;
+}
+
+#endif
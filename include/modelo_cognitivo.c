@@ -0,0 +1,53 @@
+#include "modelo_cognitivo.h"
+#include "modelo_cognitivo_dados.h"
+
+// Limite de passos por árvore, contra dados corrompidos
+#define MODELO_PASSOS_MAX 32
+
+bool modelo_disponivel(void) {
+    return MODELO_COGNITIVO_DISPONIVEL && MODELO_NUM_ARVORES > 0;
+}
+
+// Q16.16 para int16 com o deslocamento da característica, saturado
+static int16_t quantizar(q16_t v, uint8_t deslocamento) {
+    int32_t q = v.bruto >> deslocamento;
+    if (q > INT16_MAX) q = INT16_MAX;
+    if (q < INT16_MIN) q = INT16_MIN;
+    return (int16_t)q;
+}
+
+// Classifica um vetor de características; retorna false quando não há
+// modelo ou a confiança média da classe vencedora fica abaixo do mínimo
+bool modelo_classificar(const q16_t caracteristicas[MODELO_NUM_CARACTERISTICAS],
+                        EstadoMental *estado, uint8_t *confianca) {
+    if (!modelo_disponivel()) return false;
+
+    int16_t x[MODELO_NUM_CARACTERISTICAS];
+    for (int i = 0; i < MODELO_NUM_CARACTERISTICAS; i++) {
+        x[i] = quantizar(caracteristicas[i], modelo_deslocamentos[i]);
+    }
+
+    uint32_t votos[NUM_ESTADOS_COGNITIVOS] = {0};
+    for (uint32_t a = 0; a < MODELO_NUM_ARVORES; a++) {
+        uint32_t no = modelo_raizes[a];
+        for (int passo = 0; passo < MODELO_PASSOS_MAX && no < MODELO_NUM_NOS; passo++) {
+            const NoArvore *n = &modelo_nos[no];
+            if (n->caracteristica < 0) {
+                if (n->classe < NUM_ESTADOS_COGNITIVOS) votos[n->classe] += n->confianca;
+                break;
+            }
+            if (n->caracteristica >= MODELO_NUM_CARACTERISTICAS) break;
+            no = x[n->caracteristica] <= n->limiar ? no + 1 : n->direita;
+        }
+    }
+
+    uint32_t melhor = 0;
+    for (uint32_t e = 1; e < NUM_ESTADOS_COGNITIVOS; e++) {
+        if (votos[e] > votos[melhor]) melhor = e;
+    }
+    uint32_t media = votos[melhor] / MODELO_NUM_ARVORES;
+    if (media < MODELO_CONFIANCA_MIN) return false;
+    *estado = (EstadoMental)melhor;
+    *confianca = (uint8_t)media;
+    return true;
+}
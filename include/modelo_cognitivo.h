@@ -0,0 +1,41 @@
+#ifndef MODELO_COGNITIVO_H
+#define MODELO_COGNITIVO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fixo.h"
+#include "classificador.h"
+
+// Classificador do estado cognitivo treinado fora do dispositivo
+// (tools/treinar_modelo.py): um conjunto de árvores de decisão sobre as
+// características quantizadas em int16, em flash (modelo_cognitivo_dados.h).
+// Cada árvore vota na classe da folha com a confiança dela; abaixo da
+// confiança mínima, ou sem modelo, o chamador volta à tabela de regiões.
+// Não depende do SDK.
+typedef enum {
+    CARAC_ATENCAO = 0,      // 0-100%
+    CARAC_RELAXAMENTO,      // 0-10
+    CARAC_DELTA,            // Potência relativa (%)
+    CARAC_THETA,
+    CARAC_ALPHA,
+    CARAC_BETA,
+    CARAC_THETA_BETA,
+    CARAC_ENGAJAMENTO,
+    MODELO_NUM_CARACTERISTICAS
+} CaracteristicaModelo;
+
+// Nó em pré-ordem: o filho esquerdo (x <= limiar) é o nó seguinte
+typedef struct {
+    int8_t caracteristica;  // CaracteristicaModelo; -1 = folha
+    uint8_t classe;         // Folha: EstadoMental
+    uint8_t confianca;      // Folha: fração da classe nas amostras (0-255)
+    uint8_t reservado;
+    int16_t limiar;         // Na escala quantizada da característica
+    uint16_t direita;       // Índice do filho direito
+} NoArvore;
+
+bool modelo_disponivel(void);
+bool modelo_classificar(const q16_t caracteristicas[MODELO_NUM_CARACTERISTICAS],
+                        EstadoMental *estado, uint8_t *confianca);
+
+#endif
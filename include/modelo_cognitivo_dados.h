@@ -0,0 +1,86 @@
+#ifndef MODELO_COGNITIVO_DADOS_H
+#define MODELO_COGNITIVO_DADOS_H
+
+// Gerado por tools/treinar_modelo.py; não editar à mão.
+// 0 vetores gravados + 5000 sintéticos; 1 árvore(s), profundidade <= 6, 53 nós
+// Validação (1000 vetores): 96.8% de acerto nos aceitos, 0.0% devolvidos às regras
+// Sem vetores gravados: só imita a tabela de regiões, exportado desligado
+
+#include "modelo_cognitivo.h"
+
+#define MODELO_COGNITIVO_DISPONIVEL 0
+#define MODELO_NUM_ARVORES 1
+#define MODELO_NUM_NOS 53
+#define MODELO_CONFIANCA_MIN 128
+
+// Característica em int16 = Q16.16 >> deslocamento
+static const uint8_t modelo_deslocamentos[MODELO_NUM_CARACTERISTICAS] = {
+    [CARAC_ATENCAO] = 9,
+    [CARAC_RELAXAMENTO] = 6,
+    [CARAC_DELTA] = 8,
+    [CARAC_THETA] = 9,
+    [CARAC_ALPHA] = 8,
+    [CARAC_BETA] = 9,
+    [CARAC_THETA_BETA] = 6,
+    [CARAC_ENGAJAMENTO] = 7,
+};
+
+static const uint16_t modelo_raizes[MODELO_NUM_ARVORES] = {0};
+
+static const NoArvore modelo_nos[MODELO_NUM_NOS] = {
+    {0, 0, 0, 0, 3752, 8},    // 0: CARAC_ATENCAO
+    {0, 0, 0, 0, 3635, 3},    // 1: CARAC_ATENCAO
+    {-1, 0, 255, 0, 0, 0},          // 2: Distraido
+    {7, 0, 0, 0, 368, 7},    // 3: CARAC_ENGAJAMENTO
+    {7, 0, 0, 0, 305, 6},    // 4: CARAC_ENGAJAMENTO
+    {-1, 0, 255, 0, 0, 0},          // 5: Distraido
+    {-1, 0, 128, 0, 0, 0},          // 6: Distraido
+    {-1, 0, 255, 0, 0, 0},          // 7: Distraido
+    {0, 0, 0, 0, 9005, 32},    // 8: CARAC_ATENCAO
+    {1, 0, 0, 0, 7268, 23},    // 9: CARAC_RELAXAMENTO
+    {0, 0, 0, 0, 3991, 16},    // 10: CARAC_ATENCAO
+    {2, 0, 0, 0, 4812, 13},    // 11: CARAC_DELTA
+    {-1, 0, 212, 0, 0, 0},          // 12: Distraido
+    {5, 0, 0, 0, 4345, 15},    // 13: CARAC_BETA
+    {-1, 1, 142, 0, 0, 0},          // 14: Normal
+    {-1, 1, 227, 0, 0, 0},          // 15: Normal
+    {0, 0, 0, 0, 8836, 20},    // 16: CARAC_ATENCAO
+    {1, 0, 0, 0, 7112, 19},    // 17: CARAC_RELAXAMENTO
+    {-1, 1, 254, 0, 0, 0},          // 18: Normal
+    {-1, 1, 147, 0, 0, 0},          // 19: Normal
+    {4, 0, 0, 0, 1637, 22},    // 20: CARAC_ALPHA
+    {-1, 5, 177, 0, 0, 0},          // 21: Ansioso
+    {-1, 1, 161, 0, 0, 0},          // 22: Normal
+    {0, 0, 0, 0, 8891, 31},    // 23: CARAC_ATENCAO
+    {0, 0, 0, 0, 3960, 28},    // 24: CARAC_ATENCAO
+    {1, 0, 0, 0, 8893, 27},    // 25: CARAC_RELAXAMENTO
+    {-1, 3, 128, 0, 0, 0},          // 26: Relaxado
+    {-1, 3, 230, 0, 0, 0},          // 27: Relaxado
+    {1, 0, 0, 0, 7359, 30},    // 28: CARAC_RELAXAMENTO
+    {-1, 3, 228, 0, 0, 0},          // 29: Relaxado
+    {-1, 3, 254, 0, 0, 0},          // 30: Relaxado
+    {-1, 3, 153, 0, 0, 0},          // 31: Relaxado
+    {1, 0, 0, 0, 7172, 44},    // 32: CARAC_RELAXAMENTO
+    {1, 0, 0, 0, 3064, 39},    // 33: CARAC_RELAXAMENTO
+    {1, 0, 0, 0, 2975, 38},    // 34: CARAC_RELAXAMENTO
+    {0, 0, 0, 0, 9144, 37},    // 35: CARAC_ATENCAO
+    {-1, 5, 230, 0, 0, 0},          // 36: Ansioso
+    {-1, 5, 255, 0, 0, 0},          // 37: Ansioso
+    {-1, 5, 191, 0, 0, 0},          // 38: Ansioso
+    {1, 0, 0, 0, 7056, 43},    // 39: CARAC_RELAXAMENTO
+    {1, 0, 0, 0, 3329, 42},    // 40: CARAC_RELAXAMENTO
+    {-1, 2, 204, 0, 0, 0},          // 41: Concentrado
+    {-1, 2, 253, 0, 0, 0},          // 42: Concentrado
+    {-1, 2, 136, 0, 0, 0},          // 43: Concentrado
+    {0, 0, 0, 0, 9181, 48},    // 44: CARAC_ATENCAO
+    {4, 0, 0, 0, 5031, 47},    // 45: CARAC_ALPHA
+    {-1, 4, 232, 0, 0, 0},          // 46: Flow
+    {-1, 4, 153, 0, 0, 0},          // 47: Flow
+    {1, 0, 0, 0, 7352, 52},    // 48: CARAC_RELAXAMENTO
+    {2, 0, 0, 0, 1060, 51},    // 49: CARAC_DELTA
+    {-1, 4, 255, 0, 0, 0},          // 50: Flow
+    {-1, 4, 178, 0, 0, 0},          // 51: Flow
+    {-1, 4, 255, 0, 0, 0},          // 52: Flow
+};
+
+#endif
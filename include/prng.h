@@ -0,0 +1,50 @@
+#ifndef PRNG_H
+#define PRNG_H
+
+#include <stdint.h>
+
+// Gerador pseudoaleatório xorshift32 (Marsaglia): só deslocamentos e XOR,
+// sem multiplicação de 64 bits, adequado ao M0+. A mesma semente produz a
+// mesma sequência em qualquer build ou no host.
+typedef struct {
+    uint32_t estado;
+} Prng;
+
+#define PRNG_SEMENTE_PADRAO 0x2545F491u
+
+static inline void prng_semear(Prng *p, uint32_t semente) {
+    // O estado zero é absorvente no xorshift
+    p->estado = semente ? semente : PRNG_SEMENTE_PADRAO;
+}
+
+static inline uint32_t prng_proximo(Prng *p) {
+    uint32_t x = p->estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    p->estado = x;
+    return x;
+}
+
+// Uniforme em [-32768, 32767]
+static inline int32_t prng_uniforme_q15(Prng *p) {
+    return (int32_t)(prng_proximo(p) >> 16) - 32768;
+}
+
+// Uniforme em [0, n) para n <= 65536, sem divisão
+static inline uint32_t prng_intervalo(Prng *p, uint32_t n) {
+    return ((prng_proximo(p) >> 16) * n) >> 16;
+}
+
+// Aproximadamente normal N(0, 1) em Q12 (desvio padrão 4096): soma de quatro
+// uniformes de 16 bits (Irwin-Hall), limitada a cerca de +-3.5 desvios
+static inline int32_t prng_gaussiano_q12(Prng *p) {
+    uint32_t a = prng_proximo(p);
+    uint32_t b = prng_proximo(p);
+    int32_t soma = (int32_t)(a & 0xFFFF) + (int32_t)(a >> 16)
+                 + (int32_t)(b & 0xFFFF) + (int32_t)(b >> 16) - 2 * 65535;
+    // Desvio da soma = 65536 / sqrt(3); 7094 / 65536 ~= sqrt(3) * 4096 / 65536
+    return (soma * 7094) >> 16;
+}
+
+#endif
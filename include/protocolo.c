@@ -0,0 +1,285 @@
+#include "protocolo.h"
+#include <string.h>
+
+#define PROTOCOLO_US_POR_PONTO ((uint64_t)PROTOCOLO_MS_POR_PONTO * 1000u)
+
+// Sinais com alvo adaptativo (os de Dificuldade no chamador)
+#define SINAIS_ADAPTATIVOS (PROTOCOLO_BIT_SINAL(SINAL_ATENCAO) | PROTOCOLO_BIT_SINAL(SINAL_RELAXAMENTO))
+
+static uint32_t num_condicoes(const FaseProtocolo *f) {
+    uint32_t n = 0;
+    while (n < PROTOCOLO_MAX_CONDICOES && f->condicoes[n].sinal != SINAL_NENHUM) n++;
+    return n;
+}
+
+// Rejeita o que o interpretador não sabe executar: fases que nunca terminam,
+// níveis sem pontos e alvos adaptativos em sinais sem adaptação
+bool protocolo_validar(const Protocolo *p) {
+    if (p->num_fases == 0 || p->num_fases > PROTOCOLO_MAX_FASES) return false;
+    if (p->objetivo >= PROTOCOLO_NUM_OBJETIVOS) return false;
+    uint32_t niveis = 0;
+    for (uint32_t i = 0; i < p->num_fases; i++) {
+        const FaseProtocolo *f = &p->fases[i];
+        uint32_t n = num_condicoes(f);
+        for (uint32_t c = 0; c < n; c++) {
+            const CondicaoProtocolo *cond = &f->condicoes[c];
+            if (cond->sinal >= NUM_SINAIS_PROTOCOLO || cond->regra > REGRA_ALVO) return false;
+            if (cond->regra == REGRA_ALVO && !(SINAIS_ADAPTATIVOS & PROTOCOLO_BIT_SINAL(cond->sinal))) return false;
+        }
+        if (f->niveis) {
+            if (n == 0 || f->pontos_por_nivel == 0) return false;
+        } else if (f->duracao_s == 0) {
+            return false;
+        }
+        niveis += f->niveis;
+    }
+    return niveis < 255;
+}
+
+void protocolo_iniciar(ExecucaoProtocolo *e, const Protocolo *p, uint64_t agora_us) {
+    memset(e, 0, sizeof(*e));
+    e->protocolo = p;
+    e->status = PROTOCOLO_EM_ANDAMENTO;
+    e->nivel = 1;
+    e->nivel_maximo = 1;
+    for (uint32_t i = 0; i < p->num_fases; i++) {
+        e->nivel_maximo += p->fases[i].niveis;
+    }
+    e->nivel_base_fase = 1;
+    e->inicio_fase_us = agora_us;
+}
+
+// Um sinal sem valor válido nunca está no alvo, qualquer que seja a regra
+static bool condicao_atendida(const CondicaoProtocolo *c, const q16_t sinais[], const q16_t alvos[],
+                              uint32_t validos) {
+    if (!(validos & PROTOCOLO_BIT_SINAL(c->sinal))) return false;
+    q16_t v = sinais[c->sinal];
+    switch (c->regra) {
+        case REGRA_ACIMA: return q16_comparar(v, c->limiar) >= 0;
+        case REGRA_ABAIXO: return q16_comparar(v, c->limiar) <= 0;
+        case REGRA_ALVO: return q16_comparar(v, alvos[c->sinal]) >= 0;
+        default: return false;
+    }
+}
+
+uint32_t protocolo_tempo_fase_s(const ExecucaoProtocolo *e, uint64_t agora_us) {
+    return agora_us > e->inicio_fase_us ? (uint32_t)((agora_us - e->inicio_fase_us) / 1000000u) : 0;
+}
+
+// Sinais usados pelas condições de todas as fases (bits PROTOCOLO_BIT_SINAL)
+uint32_t protocolo_sinais_usados(const Protocolo *p) {
+    uint32_t usados = 0;
+    for (uint32_t i = 0; i < p->num_fases && i < PROTOCOLO_MAX_FASES; i++) {
+        const FaseProtocolo *f = &p->fases[i];
+        for (uint32_t c = 0; c < num_condicoes(f); c++) usados |= PROTOCOLO_BIT_SINAL(f->condicoes[c].sinal);
+    }
+    return usados;
+}
+
+// Um passo do interpretador com os sinais atuais, os bits dos que têm valor
+// válido e o tempo de aquisição decorrido desde o passo anterior; retorna os
+// eventos (EVENTO_PROTOCOLO_*)
+uint8_t protocolo_passo(ExecucaoProtocolo *e, const q16_t sinais[NUM_SINAIS_PROTOCOLO],
+                        const q16_t alvos[NUM_SINAIS_PROTOCOLO], uint32_t validos,
+                        uint64_t intervalo_us, uint64_t agora_us) {
+    if (e->status != PROTOCOLO_EM_ANDAMENTO) return 0;
+    const FaseProtocolo *f = &e->protocolo->fases[e->fase];
+    uint8_t eventos = 0;
+
+    uint32_t n = num_condicoes(f);
+    e->condicoes_no_alvo = 0;
+    for (uint32_t c = 0; c < n; c++) {
+        if (condicao_atendida(&f->condicoes[c], sinais, alvos, validos)) e->condicoes_no_alvo |= (uint8_t)(1u << c);
+    }
+    e->no_alvo = n > 0 && e->condicoes_no_alvo == (1u << n) - 1;
+
+    bool fim_fase = false;
+    if (e->no_alvo && intervalo_us > 0) {
+        e->tempo_no_alvo_us += intervalo_us;
+        e->tempo_no_alvo_fase_us += intervalo_us;
+        e->pontuacao = (uint32_t)(e->tempo_no_alvo_us / PROTOCOLO_US_POR_PONTO);
+
+        if (f->niveis) {
+            uint32_t conquistados = (uint32_t)(e->tempo_no_alvo_fase_us / PROTOCOLO_US_POR_PONTO) / f->pontos_por_nivel;
+            if (conquistados >= f->niveis) {
+                conquistados = f->niveis;
+                fim_fase = true;
+            }
+            uint8_t nivel = (uint8_t)(e->nivel_base_fase + conquistados);
+            if (nivel > e->nivel) {
+                e->nivel = nivel;
+                eventos |= EVENTO_PROTOCOLO_NIVEL;
+            }
+        }
+    }
+
+    if (!fim_fase && f->duracao_s && protocolo_tempo_fase_s(e, agora_us) >= f->duracao_s) {
+        if (f->niveis) {
+            e->status = PROTOCOLO_FALHA;
+            return eventos | EVENTO_PROTOCOLO_FALHA;
+        }
+        fim_fase = true;
+    }
+    if (!fim_fase) return eventos;
+
+    if (++e->fase >= e->protocolo->num_fases) {
+        e->fase = e->protocolo->num_fases - 1;
+        e->status = PROTOCOLO_CONCLUIDO;
+        return eventos | EVENTO_PROTOCOLO_CONCLUIDO;
+    }
+    e->nivel_base_fase = e->nivel;
+    e->tempo_no_alvo_fase_us = 0;
+    e->inicio_fase_us = agora_us;
+    return eventos | EVENTO_PROTOCOLO_FASE;
+}
+
+//===============================================
+// Formato de texto
+//===============================================
+// <nome> <objetivo> <fase> [<fase> ...]
+// <fase> = <condições>:<duração s>:<níveis>:<pontos por nível>:<recompensas>
+// <condições> = "-" ou até duas <condição> unidas por "+"
+// <condição> = <sinal><regra>[limiar]: sinal A (atenção), R (relaxamento),
+//   T (theta/beta), E (engajamento), S (assimetria); regra ">" (acima),
+//   "<" (abaixo) ou "^" (alvo adaptativo, sem limiar)
+// <recompensas> = "-" ou letras C (sonificação contínua), N (som por nível),
+//   F (som por fase)
+// Exemplo: "TBR 0 -:30:0:0:- T<2.5:300:9:50:CNF"
+
+static bool ler_inteiro(const char **s, uint32_t *v) {
+    const char *p = *s;
+    uint32_t r = 0;
+    if (*p < '0' || *p > '9') return false;
+    while (*p >= '0' && *p <= '9') {
+        r = r * 10 + (uint32_t)(*p++ - '0');
+        if (r > 100000) return false;
+    }
+    *v = r;
+    *s = p;
+    return true;
+}
+
+// Decimal com sinal e até 4 casas em Q16.16
+static bool ler_limiar(const char **s, q16_t *v) {
+    const char *p = *s;
+    bool negativo = false;
+    if (*p == '-') {
+        negativo = true;
+        p++;
+    }
+    uint32_t inteiro;
+    if (!ler_inteiro(&p, &inteiro) || inteiro > 30000) return false;
+    uint32_t fracao = 0, escala = 1;
+    if (*p == '.') {
+        p++;
+        while (*p >= '0' && *p <= '9') {
+            if (escala < 10000) {
+                fracao = fracao * 10 + (uint32_t)(*p - '0');
+                escala *= 10;
+            }
+            p++;
+        }
+    }
+    q16_t r = Q16_BRUTO((inteiro << Q16_FRAC) + (((uint64_t)fracao << Q16_FRAC) + escala / 2) / escala);
+    *v = negativo ? q16_negar(r) : r;
+    *s = p;
+    return true;
+}
+
+static bool ler_condicao(const char **s, CondicaoProtocolo *c) {
+    static const char sinais[] = {
+        [SINAL_ATENCAO] = 'A', [SINAL_RELAXAMENTO] = 'R', [SINAL_THETA_BETA] = 'T',
+        [SINAL_ENGAJAMENTO] = 'E', [SINAL_ASSIMETRIA] = 'S',
+    };
+    const char *p = *s;
+    c->sinal = SINAL_NENHUM;
+    for (uint8_t i = SINAL_ATENCAO; i < NUM_SINAIS_PROTOCOLO; i++) {
+        if (*p == sinais[i]) c->sinal = i;
+    }
+    if (c->sinal == SINAL_NENHUM) return false;
+    p++;
+    c->limiar = Q16_ZERO;
+    switch (*p++) {
+        case '>': c->regra = REGRA_ACIMA; break;
+        case '<': c->regra = REGRA_ABAIXO; break;
+        case '^': c->regra = REGRA_ALVO; break;
+        default: return false;
+    }
+    if (c->regra != REGRA_ALVO && !ler_limiar(&p, &c->limiar)) return false;
+    *s = p;
+    return true;
+}
+
+static bool ler_fase(const char **s, FaseProtocolo *f) {
+    const char *p = *s;
+    uint32_t v;
+    memset(f, 0, sizeof(*f));
+
+    if (*p == '-') {
+        p++;
+    } else {
+        for (uint32_t c = 0; ; c++) {
+            if (c >= PROTOCOLO_MAX_CONDICOES || !ler_condicao(&p, &f->condicoes[c])) return false;
+            if (*p != '+') break;
+            p++;
+        }
+    }
+
+    if (*p++ != ':' || !ler_inteiro(&p, &v) || v > UINT16_MAX) return false;
+    f->duracao_s = (uint16_t)v;
+    if (*p++ != ':' || !ler_inteiro(&p, &v) || v > UINT8_MAX) return false;
+    f->niveis = (uint8_t)v;
+    if (*p++ != ':' || !ler_inteiro(&p, &v) || v > UINT16_MAX) return false;
+    f->pontos_por_nivel = (uint16_t)v;
+    if (*p++ != ':') return false;
+    if (*p == '-') {
+        p++;
+    } else {
+        for (; *p && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n'; p++) {
+            switch (*p) {
+                case 'C': f->recompensas |= RECOMPENSA_SONIFICACAO; break;
+                case 'N': f->recompensas |= RECOMPENSA_SOM_NIVEL; break;
+                case 'F': f->recompensas |= RECOMPENSA_SOM_FASE; break;
+                default: return false;
+            }
+        }
+    }
+    *s = p;
+    return true;
+}
+
+static void pular_espacos(const char **s) {
+    while (**s == ' ' || **s == '\t') (*s)++;
+}
+
+// Lê um protocolo do formato de texto; *p só é alterado se ele for válido
+bool protocolo_interpretar_texto(const char *texto, Protocolo *p) {
+    Protocolo novo;
+    memset(&novo, 0, sizeof(novo));
+    const char *s = texto;
+    uint32_t v;
+
+    pular_espacos(&s);
+    uint32_t n = 0;
+    while (*s && *s != ' ' && *s != '\t') {
+        if (n + 1 >= PROTOCOLO_TAM_NOME) return false;
+        novo.nome[n++] = *s++;
+    }
+    if (n == 0) return false;
+
+    pular_espacos(&s);
+    if (!ler_inteiro(&s, &v) || v >= PROTOCOLO_NUM_OBJETIVOS) return false;
+    novo.objetivo = (uint8_t)v;
+
+    for (;;) {
+        pular_espacos(&s);
+        if (*s == '\0' || *s == '\r' || *s == '\n') break;
+        if (novo.num_fases >= PROTOCOLO_MAX_FASES) return false;
+        if (!ler_fase(&s, &novo.fases[novo.num_fases])) return false;
+        novo.num_fases++;
+    }
+
+    if (!protocolo_validar(&novo)) return false;
+    *p = novo;
+    return true;
+}
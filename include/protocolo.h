@@ -0,0 +1,112 @@
+#ifndef PROTOCOLO_H
+#define PROTOCOLO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fixo.h"
+
+// Protocolos de treino descritos como dados: uma sequência de fases, cada
+// uma com até duas condições sobre os sinais (todas precisam valer para
+// contar como no alvo), duração, níveis a conquistar, pontos por nível e as
+// recompensas que o chamador toca. O interpretador avança um passo por
+// ciclo em tempo constante: no máximo duas condições e uma troca de fase.
+// Um sinal sem valor válido no passo (métrica ainda não avaliada, derivação
+// ausente) nunca está no alvo. Os protocolos também podem chegar como uma
+// linha de texto. Não depende do SDK.
+#define PROTOCOLO_MAX_FASES 6
+#define PROTOCOLO_MAX_CONDICOES 2
+#define PROTOCOLO_TAM_NOME 12
+
+// Categorias de objetivo: 0=Atenção, 1=Relaxamento, 2=Flow, 3=Theta/Beta
+#define PROTOCOLO_NUM_OBJETIVOS 4
+
+// Um ponto a cada 50 ms no alvo
+#define PROTOCOLO_MS_POR_PONTO 50
+
+typedef enum {
+    SINAL_NENHUM = 0,
+    SINAL_ATENCAO,          // 0-100%
+    SINAL_RELAXAMENTO,      // 0-10
+    SINAL_THETA_BETA,       // Razão theta/beta
+    SINAL_ENGAJAMENTO,      // Beta / (alpha + theta)
+    SINAL_ASSIMETRIA,       // Assimetria alfa, -1 a 1
+    NUM_SINAIS_PROTOCOLO
+} SinalProtocolo;
+
+#define PROTOCOLO_BIT_SINAL(s) (1u << (s))
+
+typedef enum {
+    REGRA_ACIMA = 0,        // sinal >= limiar
+    REGRA_ABAIXO,           // sinal <= limiar
+    REGRA_ALVO,             // sinal >= alvo adaptativo (só atenção e relaxamento)
+} RegraProtocolo;
+
+// Recompensas (bits)
+#define RECOMPENSA_SONIFICACAO 0x01     // Sonificação contínua durante a fase
+#define RECOMPENSA_SOM_NIVEL 0x02       // Som a cada nível conquistado
+#define RECOMPENSA_SOM_FASE 0x04        // Som ao passar para a próxima fase
+
+typedef struct {
+    uint8_t sinal;          // SinalProtocolo; SINAL_NENHUM encerra a lista
+    uint8_t regra;          // RegraProtocolo
+    q16_t limiar;           // Ignorado em REGRA_ALVO
+} CondicaoProtocolo;
+
+// Uma fase termina ao conquistar os níveis dela ou, sem níveis (linha de
+// base), ao fim da duração. Com níveis, esgotar a duração é falha.
+typedef struct {
+    CondicaoProtocolo condicoes[PROTOCOLO_MAX_CONDICOES];
+    uint16_t duracao_s;     // 0 = sem limite (exige níveis)
+    uint8_t niveis;
+    uint8_t recompensas;
+    uint16_t pontos_por_nivel;
+} FaseProtocolo;
+
+typedef struct {
+    char nome[PROTOCOLO_TAM_NOME];
+    uint8_t objetivo;       // Categoria para as sessões e LEDs (< PROTOCOLO_NUM_OBJETIVOS)
+    uint8_t num_fases;
+    FaseProtocolo fases[PROTOCOLO_MAX_FASES];
+} Protocolo;
+
+typedef enum {
+    PROTOCOLO_EM_ANDAMENTO = 0,
+    PROTOCOLO_CONCLUIDO,
+    PROTOCOLO_FALHA,
+} StatusProtocolo;
+
+// Eventos de um passo (bits)
+#define EVENTO_PROTOCOLO_NIVEL 0x01
+#define EVENTO_PROTOCOLO_FASE 0x02
+#define EVENTO_PROTOCOLO_CONCLUIDO 0x04
+#define EVENTO_PROTOCOLO_FALHA 0x08
+
+typedef struct {
+    const Protocolo *protocolo;
+    uint8_t status;                 // StatusProtocolo
+    uint8_t fase;
+    uint8_t nivel;                  // Começa em 1
+    uint8_t nivel_maximo;           // 1 + níveis de todas as fases
+    uint8_t nivel_base_fase;        // Nível ao entrar na fase
+    uint8_t condicoes_no_alvo;      // Bits das condições atendidas no último passo
+    bool no_alvo;                   // Todas as condições da fase atendidas
+    uint32_t pontuacao;
+    uint64_t tempo_no_alvo_us;      // Na sessão
+    uint64_t tempo_no_alvo_fase_us;
+    uint64_t inicio_fase_us;
+} ExecucaoProtocolo;
+
+bool protocolo_validar(const Protocolo *p);
+void protocolo_iniciar(ExecucaoProtocolo *e, const Protocolo *p, uint64_t agora_us);
+uint8_t protocolo_passo(ExecucaoProtocolo *e, const q16_t sinais[NUM_SINAIS_PROTOCOLO],
+                        const q16_t alvos[NUM_SINAIS_PROTOCOLO], uint32_t validos,
+                        uint64_t intervalo_us, uint64_t agora_us);
+uint32_t protocolo_sinais_usados(const Protocolo *p);
+uint32_t protocolo_tempo_fase_s(const ExecucaoProtocolo *e, uint64_t agora_us);
+bool protocolo_interpretar_texto(const char *texto, Protocolo *p);
+
+static inline const FaseProtocolo *protocolo_fase(const ExecucaoProtocolo *e) {
+    return &e->protocolo->fases[e->fase < e->protocolo->num_fases ? e->fase : e->protocolo->num_fases - 1];
+}
+
+#endif
@@ -0,0 +1,42 @@
+#include "quantil.h"
+#include <string.h>
+
+void quantil_init(HistogramaQuantil *h, q16_t minimo, q16_t maximo) {
+    h->minimo = minimo;
+    h->largura_bin = q16_escalar(q16_subtrair(maximo, minimo), 1, QUANTIL_NUM_BINS);
+    if (h->largura_bin.bruto < 1) h->largura_bin = Q16_BRUTO(1);
+    quantil_zerar(h);
+}
+
+void quantil_zerar(HistogramaQuantil *h) {
+    h->total = 0;
+    memset(h->contagem, 0, sizeof(h->contagem));
+}
+
+void quantil_adicionar(HistogramaQuantil *h, q16_t x) {
+    int32_t bin = q16_subtrair(x, h->minimo).bruto / h->largura_bin.bruto;
+    if (bin < 0) bin = 0;
+    if (bin >= QUANTIL_NUM_BINS) bin = QUANTIL_NUM_BINS - 1;
+    h->contagem[bin]++;
+    h->total++;
+}
+
+// Quantil em milésimos (500 = mediana). As amostras de cada bin são
+// tratadas como espalhadas uniformemente por ele.
+q16_t quantil_consultar(const HistogramaQuantil *h, uint16_t milesimos) {
+    if (h->total == 0) return h->minimo;
+    if (milesimos > 1000) milesimos = 1000;
+
+    // Posição procurada, em milésimos de amostra
+    uint64_t alvo = (uint64_t)h->total * milesimos;
+    uint64_t acumulado = 0;
+    for (uint32_t b = 0; b < QUANTIL_NUM_BINS; b++) {
+        uint64_t bin = (uint64_t)h->contagem[b] * 1000;
+        if (bin > 0 && acumulado + bin >= alvo) {
+            int64_t dentro = (int64_t)(((alvo - acumulado) * (uint64_t)h->largura_bin.bruto) / bin);
+            return q16_somar(h->minimo, Q16_BRUTO(b * h->largura_bin.bruto + dentro));
+        }
+        acumulado += bin;
+    }
+    return q16_somar(h->minimo, Q16_BRUTO(QUANTIL_NUM_BINS * h->largura_bin.bruto));
+}
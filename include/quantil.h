@@ -0,0 +1,26 @@
+#ifndef QUANTIL_H
+#define QUANTIL_H
+
+#include <stdint.h>
+#include "fixo.h"
+
+// Quantis de uma série Q16.16 em memória constante: histograma de bins
+// fixos sobre a faixa conhecida do sinal, com interpolação linear dentro do
+// bin na consulta. Inserção O(1); consulta O(bins), a qualquer momento. O
+// erro fica abaixo da largura de um bin (faixa / QUANTIL_NUM_BINS) e a
+// memória não cresce com a sessão. Não depende do SDK.
+#define QUANTIL_NUM_BINS 256
+
+typedef struct {
+    q16_t minimo;               // Início da faixa; valores fora dela vão aos bins das pontas
+    q16_t largura_bin;
+    uint32_t total;
+    uint32_t contagem[QUANTIL_NUM_BINS];
+} HistogramaQuantil;
+
+void quantil_init(HistogramaQuantil *h, q16_t minimo, q16_t maximo);
+void quantil_zerar(HistogramaQuantil *h);
+void quantil_adicionar(HistogramaQuantil *h, q16_t x);
+q16_t quantil_consultar(const HistogramaQuantil *h, uint16_t milesimos);
+
+#endif
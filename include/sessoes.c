@@ -0,0 +1,41 @@
+#include "sessoes.h"
+#include <string.h>
+
+void sessoes_init(HistoricoSessoes *h) {
+    memset(h, 0, sizeof(*h));
+}
+
+static bool melhor_que(const RegistroSessao *a, const RegistroSessao *b) {
+    if (a->pontuacao != b->pontuacao) return a->pontuacao > b->pontuacao;
+    return a->duracao_s < b->duracao_s;
+}
+
+void sessoes_adicionar(HistoricoSessoes *h, const RegistroSessao *r) {
+    h->registros[h->total % SESSOES_CAPACIDADE] = *r;
+    h->total++;
+
+    if (r->objetivo >= SESSOES_NUM_OBJETIVOS) return;
+    ResumoObjetivo *resumo = &h->resumo[r->objetivo];
+    resumo->sessoes++;
+    if (r->concluida) resumo->concluidas++;
+    resumo->tempo_no_alvo_ms += r->tempo_no_alvo_ms;
+    if (!resumo->tem_melhor || melhor_que(r, &resumo->melhor)) {
+        resumo->melhor = *r;
+        resumo->tem_melhor = true;
+    }
+}
+
+// Registros ainda no anel
+uint32_t sessoes_quantidade(const HistoricoSessoes *h) {
+    return h->total < SESSOES_CAPACIDADE ? h->total : SESSOES_CAPACIDADE;
+}
+
+// Registro por idade (0 = o mais recente), ou NULL
+const RegistroSessao *sessoes_obter(const HistoricoSessoes *h, uint32_t idade) {
+    if (idade >= sessoes_quantidade(h)) return NULL;
+    return &h->registros[(h->total - 1 - idade) % SESSOES_CAPACIDADE];
+}
+
+const ResumoObjetivo *sessoes_resumo(const HistoricoSessoes *h, uint8_t objetivo) {
+    return objetivo < SESSOES_NUM_OBJETIVOS ? &h->resumo[objetivo] : NULL;
+}
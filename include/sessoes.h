@@ -0,0 +1,48 @@
+#ifndef SESSOES_H
+#define SESSOES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "classificador.h"
+
+// Registro das sessões de treino na RAM: anel de capacidade fixa com
+// registros compactos (inserção O(1), sem heap; os mais antigos saem quando
+// o anel enche) e agregados por objetivo mantidos a cada inserção, para que
+// consultas como a melhor sessão não percorram os registros. O agregado
+// guarda uma cópia da melhor sessão, que sobrevive à saída dela do anel.
+// Não depende do SDK.
+#define SESSOES_CAPACIDADE 32
+#define SESSOES_NUM_OBJETIVOS 4     // Atenção, relaxamento, estado flow, theta/beta
+
+typedef struct {
+    uint32_t inicio_s;              // Desde a inicialização
+    uint32_t tempo_no_alvo_ms;
+    uint16_t duracao_s;
+    uint16_t pontuacao;
+    uint16_t tempo_estado_s[NUM_ESTADOS_COGNITIVOS];
+    uint8_t objetivo;
+    uint8_t nivel_final;
+    bool concluida;                 // Todos os níveis completados
+} RegistroSessao;
+
+typedef struct {
+    uint32_t sessoes;
+    uint32_t concluidas;
+    uint64_t tempo_no_alvo_ms;
+    bool tem_melhor;
+    RegistroSessao melhor;          // Maior pontuação; no empate, a mais curta
+} ResumoObjetivo;
+
+typedef struct {
+    RegistroSessao registros[SESSOES_CAPACIDADE];
+    uint32_t total;                 // Sessões já registradas (inclui as que saíram do anel)
+    ResumoObjetivo resumo[SESSOES_NUM_OBJETIVOS];
+} HistoricoSessoes;
+
+void sessoes_init(HistoricoSessoes *h);
+void sessoes_adicionar(HistoricoSessoes *h, const RegistroSessao *r);
+uint32_t sessoes_quantidade(const HistoricoSessoes *h);
+const RegistroSessao *sessoes_obter(const HistoricoSessoes *h, uint32_t idade);
+const ResumoObjetivo *sessoes_resumo(const HistoricoSessoes *h, uint8_t objetivo);
+
+#endif
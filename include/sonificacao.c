@@ -0,0 +1,134 @@
+#include "sonificacao.h"
+#include "hardware/pwm.h"
+#include "hardware/clocks.h"
+
+// O contador PWM roda a 1 MHz: o período do tom é expresso diretamente em us
+#define CONTADOR_HZ 1000000u
+
+// Constante de tempo do deslizamento de frequência (em ticks, potência de 2)
+#define GLIDE_SHIFT 3
+
+static uint pino;
+static uint slice;
+static uint canal;
+static struct repeating_timer timer;
+static volatile bool ativa = false;
+
+// Alvos calculados no loop principal e consumidos pelo ISR
+static volatile uint32_t alvo_periodo = CONTADOR_HZ / SONIFICACAO_FREQ_MIN;
+static volatile uint32_t alvo_incremento_pulso = 0;
+
+// Estado privado do ISR
+static uint32_t periodo_atual = CONTADOR_HZ / SONIFICACAO_FREQ_MIN;
+static uint32_t fase_pulso = 0;
+
+// Atenuação (deslocamento aplicado ao ciclo útil) enquanto há alertas
+static volatile uint8_t atenuacao = 0;
+
+// Suspensão temporária (enquanto outro som usa o mesmo buzzer)
+static volatile bool suspensa = false;
+static volatile uint32_t retomar_em_us = 0;
+
+// Configura o slice para o tom contínuo (feito uma única vez por sessão)
+static void configurar_pwm(void) {
+    gpio_set_function(pino, GPIO_FUNC_PWM);
+    pwm_set_clkdiv(slice, (float)clock_get_hz(clk_sys) / CONTADOR_HZ);
+    pwm_set_wrap(slice, periodo_atual - 1);
+    pwm_set_chan_level(slice, canal, 0);
+    pwm_set_enabled(slice, true);
+}
+
+// ISR periódico: ajusta TOP e nível de comparação do PWM. Ambos os
+// registradores são carregados pelo hardware somente no fim do período
+// corrente, então a troca de frequência ocorre sem cortes no sinal.
+static bool sonificacao_tick(struct repeating_timer *t) {
+    if (suspensa) {
+        if ((int32_t)(time_us_32() - retomar_em_us) < 0) {
+            return true;
+        }
+        configurar_pwm();
+        suspensa = false;
+    }
+
+    int32_t diferenca = (int32_t)alvo_periodo - (int32_t)periodo_atual;
+    periodo_atual += diferenca >> GLIDE_SHIFT;
+    if (diferenca != 0 && (diferenca >> GLIDE_SHIFT) == 0) {
+        periodo_atual += (diferenca > 0) ? 1 : -1;
+    }
+
+    fase_pulso += alvo_incremento_pulso;
+    bool ligado = fase_pulso < 0x80000000u;
+
+    pwm_set_wrap(slice, periodo_atual - 1);
+    pwm_set_chan_level(slice, canal, ligado ? periodo_atual >> (1 + atenuacao) : 0);
+    return true;
+}
+
+void sonificacao_init(uint gpio) {
+    pino = gpio;
+    slice = pwm_gpio_to_slice_num(gpio);
+    canal = pwm_gpio_to_channel(gpio);
+}
+
+void sonificacao_iniciar(void) {
+    if (ativa) return;
+
+    periodo_atual = alvo_periodo;
+    fase_pulso = 0;
+    suspensa = false;
+    configurar_pwm();
+
+    // Período negativo: intervalo medido entre inícios de callback (taxa fixa)
+    add_repeating_timer_us(-(int64_t)(1000000 / SONIFICACAO_TAXA_HZ), sonificacao_tick, NULL, &timer);
+    ativa = true;
+}
+
+void sonificacao_parar(void) {
+    if (!ativa) return;
+
+    cancel_repeating_timer(&timer);
+    ativa = false;
+
+    // Se outro som está usando o buzzer, ele mesmo devolve o pino ao final
+    if (suspensa) {
+        suspensa = false;
+        return;
+    }
+
+    pwm_set_enabled(slice, false);
+    gpio_set_function(pino, GPIO_FUNC_SIO);
+    gpio_set_dir(pino, GPIO_OUT);
+    gpio_put(pino, 0);
+}
+
+bool sonificacao_ativa(void) {
+    return ativa;
+}
+
+// Converte atenção (0-100%) em altura e relaxamento (0-10) em taxa de pulsos.
+// Chamado no loop principal; o ISR apenas lê os alvos já convertidos.
+void sonificacao_definir_alvo(q16_t atencao, q16_t relaxamento) {
+    atencao = q16_limitar(atencao, Q16_ZERO, Q16_INT(100));
+    relaxamento = q16_limitar(relaxamento, Q16_ZERO, Q16_INT(10));
+
+    uint32_t freq = SONIFICACAO_FREQ_MIN + (uint32_t)q16_para_int(
+        q16_mul(atencao, Q16_CONST((SONIFICACAO_FREQ_MAX - SONIFICACAO_FREQ_MIN) / 100.0)));
+    uint32_t pulso_dhz = SONIFICACAO_PULSO_MAX_DHZ - (uint32_t)q16_para_int(
+        q16_mul(relaxamento, Q16_CONST((SONIFICACAO_PULSO_MAX_DHZ - SONIFICACAO_PULSO_MIN_DHZ) / 10.0)));
+
+    alvo_periodo = CONTADOR_HZ / freq;
+    alvo_incremento_pulso = (uint32_t)(((uint64_t)pulso_dhz << 32) / (10u * SONIFICACAO_TAXA_HZ));
+}
+
+// Libera o buzzer por um intervalo para outro som; o ISR reassume o pino
+// ao final reprogramando o slice uma única vez.
+void sonificacao_suspender(uint32_t duracao_ms) {
+    if (!ativa) return;
+    retomar_em_us = time_us_32() + duracao_ms * 1000u;
+    suspensa = true;
+}
+
+// Reduz o volume do tom contínuo (ducking) sem interrompê-lo
+void sonificacao_atenuar(uint8_t deslocamento) {
+    atenuacao = deslocamento;
+}
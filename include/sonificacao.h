@@ -0,0 +1,26 @@
+#ifndef SONIFICACAO_H
+#define SONIFICACAO_H
+
+#include "pico/stdlib.h"
+#include "fixo.h"
+
+// Taxa de atualização do tom contínuo (Hz)
+#define SONIFICACAO_TAXA_HZ 200
+
+// Faixa de frequências usada para representar a atenção (Hz)
+#define SONIFICACAO_FREQ_MIN 220
+#define SONIFICACAO_FREQ_MAX 880
+
+// Faixa da taxa de pulsos usada para representar o relaxamento (Hz x 10)
+#define SONIFICACAO_PULSO_MIN_DHZ 10   // 1 pulso/s com relaxamento máximo
+#define SONIFICACAO_PULSO_MAX_DHZ 80   // 8 pulsos/s com relaxamento mínimo
+
+void sonificacao_init(uint gpio);
+void sonificacao_iniciar(void);
+void sonificacao_parar(void);
+bool sonificacao_ativa(void);
+void sonificacao_definir_alvo(q16_t atencao, q16_t relaxamento);
+void sonificacao_suspender(uint32_t duracao_ms);
+void sonificacao_atenuar(uint8_t deslocamento);
+
+#endif
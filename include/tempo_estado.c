@@ -0,0 +1,63 @@
+#include "tempo_estado.h"
+#include <string.h>
+
+void tempo_estado_zerar(ContagemEstados *t) {
+    memset(t, 0, sizeof(*t));
+}
+
+// Fecha o intervalo aberto do estado atual em fim_us
+static void fechar_intervalo(ContagemEstados *t, uint64_t fim_us) {
+    if (fim_us > t->inicio_us) t->tempo_us[t->atual] += fim_us - t->inicio_us;
+    t->inicio_us = fim_us;
+}
+
+// Registra o estado do ciclo; evento é a transição aceita nele (ou NULL).
+// O tempo entre a transição e o registro já conta para o estado novo.
+void tempo_estado_registrar(ContagemEstados *t, EstadoMental estado, uint64_t agora_us,
+                            const EventoTransicao *evento) {
+    if (!t->iniciado) {
+        t->atual = estado;
+        t->entradas[estado]++;
+        t->inicio_us = agora_us;
+        t->ultimo_us = agora_us;
+        t->iniciado = true;
+        return;
+    }
+
+    // Pausa longa: o intervalo termina no último registro e recomeça agora
+    if (agora_us - t->ultimo_us > TEMPO_ESTADO_PAUSA_MAX_US) {
+        fechar_intervalo(t, t->ultimo_us);
+        t->inicio_us = agora_us;
+    }
+
+    if (evento) {
+        uint64_t instante = evento->instante_us;
+        if (instante < t->inicio_us) instante = t->inicio_us;
+        fechar_intervalo(t, instante);
+        t->matriz[evento->de][evento->para]++;
+        t->entradas[evento->para]++;
+        t->transicoes++;
+        t->atual = evento->para;
+    } else if (estado != t->atual) {
+        // Estado mudou sem evento (classificador reiniciado): só troca
+        fechar_intervalo(t, agora_us);
+        t->atual = estado;
+        t->entradas[estado]++;
+    }
+    t->ultimo_us = agora_us;
+}
+
+// Tempo total no estado, incluindo o intervalo em aberto
+uint64_t tempo_estado_us(const ContagemEstados *t, EstadoMental estado) {
+    uint64_t tempo = t->tempo_us[estado];
+    if (t->iniciado && estado == t->atual && t->ultimo_us > t->inicio_us) {
+        tempo += t->ultimo_us - t->inicio_us;
+    }
+    return tempo;
+}
+
+uint64_t tempo_estado_total_us(const ContagemEstados *t) {
+    uint64_t total = 0;
+    for (int e = 0; e < NUM_ESTADOS_COGNITIVOS; e++) total += tempo_estado_us(t, (EstadoMental)e);
+    return total;
+}
@@ -0,0 +1,33 @@
+#ifndef TEMPO_ESTADO_H
+#define TEMPO_ESTADO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "classificador.h"
+
+// Contabilidade do tempo em cada estado cognitivo, mantida a partir dos
+// eventos de transição do classificador: tempo de permanência por estado
+// (µs, no relógio da aquisição), entradas em cada estado, total de
+// transições e a matriz de transições [de][para]. Intervalos sem
+// classificação mais longos que TEMPO_ESTADO_PAUSA_MAX_US (outra tela
+// ativa) não contam para nenhum estado. Não depende do SDK.
+#define TEMPO_ESTADO_PAUSA_MAX_US 1000000u
+
+typedef struct {
+    uint64_t tempo_us[NUM_ESTADOS_COGNITIVOS];      // Intervalos já fechados
+    uint32_t entradas[NUM_ESTADOS_COGNITIVOS];
+    uint32_t matriz[NUM_ESTADOS_COGNITIVOS][NUM_ESTADOS_COGNITIVOS];
+    uint32_t transicoes;
+    EstadoMental atual;
+    uint64_t inicio_us;         // Início do intervalo aberto no estado atual
+    uint64_t ultimo_us;         // Último registro
+    bool iniciado;
+} ContagemEstados;
+
+void tempo_estado_zerar(ContagemEstados *t);
+void tempo_estado_registrar(ContagemEstados *t, EstadoMental estado, uint64_t agora_us,
+                            const EventoTransicao *evento);
+uint64_t tempo_estado_us(const ContagemEstados *t, EstadoMental estado);
+uint64_t tempo_estado_total_us(const ContagemEstados *t);
+
+#endif
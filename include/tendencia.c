@@ -0,0 +1,217 @@
+#include "tendencia.h"
+#include <string.h>
+
+// Duração e quantidade de baldes de cada nível, do mais fino ao mais grosso
+static const struct {
+    uint32_t duracao_s;
+    uint16_t capacidade;
+} definicao_niveis[TENDENCIA_NUM_NIVEIS] = {
+    {1, 120},       // 2 min
+    {10, 180},      // 30 min
+    {60, 240},      // 4 h
+};
+
+static inline int16_t para_q8(q16_t v) {
+    int32_t q = v.bruto >> 8;
+    if (q > INT16_MAX) q = INT16_MAX;
+    if (q <= INT16_MIN) q = INT16_MIN + 1;     // INT16_MIN marca balde vazio
+    return (int16_t)q;
+}
+
+static inline q16_t de_q8(int16_t v) {
+    return Q16_BRUTO((int32_t)v * 256);
+}
+
+static void abrir_balde(NivelTendencia *n, uint32_t indice) {
+    n->indice = indice;
+    n->amostras = 0;
+    for (int c = 0; c < TENDENCIA_NUM_CANAIS; c++) n->soma[c] = 0;
+}
+
+static void empurrar(NivelTendencia *n, const BaldeTendencia *b) {
+    n->baldes[n->proximo] = *b;
+    n->proximo = (uint16_t)((n->proximo + 1) % n->capacidade);
+    if (n->cheios < n->capacidade) n->cheios++;
+}
+
+// Fecha o balde aberto e os vazios até o novo índice
+static void fechar_ate(NivelTendencia *n, uint32_t novo_indice) {
+    BaldeTendencia b;
+    for (int c = 0; c < TENDENCIA_NUM_CANAIS; c++) {
+        if (n->amostras) {
+            b.canal[c].minimo = para_q8(n->minimo[c]);
+            b.canal[c].media = para_q8(Q16_BRUTO(n->soma[c] / (int64_t)n->amostras));
+            b.canal[c].maximo = para_q8(n->maximo[c]);
+        } else {
+            b.canal[c].minimo = b.canal[c].media = b.canal[c].maximo = TENDENCIA_VAZIO;
+        }
+    }
+    empurrar(n, &b);
+
+    // Lacuna sem amostras; acima da capacidade só o anel inteiro importa
+    uint32_t vazios = novo_indice - n->indice - 1;
+    if (vazios > n->capacidade) vazios = n->capacidade;
+    for (int c = 0; c < TENDENCIA_NUM_CANAIS; c++) {
+        b.canal[c].minimo = b.canal[c].media = b.canal[c].maximo = TENDENCIA_VAZIO;
+    }
+    while (vazios--) empurrar(n, &b);
+
+    abrir_balde(n, novo_indice);
+}
+
+void tendencia_init(Tendencia *t) {
+    memset(t, 0, sizeof(*t));
+    BaldeTendencia *memoria = t->memoria;
+    for (int i = 0; i < TENDENCIA_NUM_NIVEIS; i++) {
+        NivelTendencia *n = &t->niveis[i];
+        n->duracao_s = definicao_niveis[i].duracao_s;
+        n->capacidade = definicao_niveis[i].capacidade;
+        n->baldes = memoria;
+        memoria += n->capacidade;
+    }
+}
+
+void tendencia_adicionar(Tendencia *t, uint64_t instante_us, const q16_t valores[TENDENCIA_NUM_CANAIS]) {
+    uint32_t segundos = (uint32_t)(instante_us / 1000000u);
+    for (int i = 0; i < TENDENCIA_NUM_NIVEIS; i++) {
+        NivelTendencia *n = &t->niveis[i];
+        uint32_t indice = segundos / n->duracao_s;
+        if (!t->iniciado) {
+            abrir_balde(n, indice);
+        } else if (indice > n->indice) {
+            fechar_ate(n, indice);
+        }
+
+        for (int c = 0; c < TENDENCIA_NUM_CANAIS; c++) {
+            q16_t v = valores[c];
+            n->minimo[c] = n->amostras ? q16_min(n->minimo[c], v) : v;
+            n->maximo[c] = n->amostras ? q16_max(n->maximo[c], v) : v;
+            n->soma[c] += v.bruto;
+        }
+        n->amostras++;
+    }
+    t->iniciado = true;
+}
+
+// Nível para uma janela: o mais grosso que cobre a janela com pelo menos
+// min_baldes baldes; senão o mais fino que a cobre; senão o mais grosso
+int tendencia_escolher_nivel(const Tendencia *t, uint32_t janela_s, uint32_t min_baldes) {
+    if (min_baldes < 1) min_baldes = 1;
+    for (int i = TENDENCIA_NUM_NIVEIS - 1; i >= 0; i--) {
+        const NivelTendencia *n = &t->niveis[i];
+        uint32_t baldes = (janela_s + n->duracao_s - 1) / n->duracao_s;
+        if (baldes <= n->capacidade && baldes >= min_baldes) return i;
+    }
+    for (int i = 0; i < TENDENCIA_NUM_NIVEIS; i++) {
+        const NivelTendencia *n = &t->niveis[i];
+        if (janela_s <= n->duracao_s * n->capacidade) return i;
+    }
+    return TENDENCIA_NUM_NIVEIS - 1;
+}
+
+// Balde fechado de um nível por idade (0 = o mais recente)
+bool tendencia_balde(const Tendencia *t, int nivel, uint32_t idade, BaldeTendencia *balde) {
+    const NivelTendencia *n = &t->niveis[nivel];
+    if (idade >= n->cheios) return false;
+    uint32_t pos = (n->proximo + n->capacidade - 1 - idade) % n->capacidade;
+    *balde = n->baldes[pos];
+    return true;
+}
+
+// Junta um balde ao ponto; a média entra com o peso dado
+static void acumular(PontoTendencia *p, q16_t minimo, q16_t media, q16_t maximo, uint32_t peso,
+                     int64_t *soma, uint32_t *num) {
+    p->minimo = p->valido ? q16_min(p->minimo, minimo) : minimo;
+    p->maximo = p->valido ? q16_max(p->maximo, maximo) : maximo;
+    p->valido = true;
+    *soma += (int64_t)media.bruto * peso;
+    *num += peso;
+}
+
+// Mínimo, média e máximo de um canal nos últimos janela_s segundos (o
+// segundo atual e os janela_s - 1 anteriores). Começa pelo balde aberto do
+// nível mais grosso cujo balde cabe na janela e recua pelos baldes fechados
+// dele enquanto começam dentro da janela; o trecho que sobra antes deles vem
+// dos níveis mais finos, para nenhum balde trazer amostras de antes da
+// janela. A média pondera cada balde pelos segundos que ele cobre.
+PontoTendencia tendencia_resumo(const Tendencia *t, uint8_t canal, uint32_t janela_s) {
+    PontoTendencia p = {0};
+    if (!t->iniciado || janela_s == 0) return p;
+    int nivel = 0;
+    for (int i = TENDENCIA_NUM_NIVEIS - 1; i > 0; i--) {
+        if (t->niveis[i].duracao_s <= janela_s) {
+            nivel = i;
+            break;
+        }
+    }
+
+    // O nível de 1 s tem o segundo atual como balde aberto
+    uint32_t agora_s = t->niveis[0].indice;
+    uint32_t inicio_s = agora_s + 1 >= janela_s ? agora_s + 1 - janela_s : 0;
+    const NivelTendencia *n = &t->niveis[nivel];
+    uint32_t fim_s = n->indice * n->duracao_s;     // Início do trecho já coberto
+    int64_t soma = 0;
+    uint32_t segundos = 0;
+
+    if (n->amostras) {
+        acumular(&p, n->minimo[canal], Q16_BRUTO(n->soma[canal] / (int64_t)n->amostras),
+                 n->maximo[canal], agora_s + 1 - fim_s, &soma, &segundos);
+    }
+    for (int i = nivel; i >= 0; i--) {
+        n = &t->niveis[i];
+        // Os baldes que terminam depois de fim_s já vieram do nível acima
+        BaldeTendencia b;
+        for (uint32_t idade = n->indice - fim_s / n->duracao_s;
+             fim_s >= inicio_s + n->duracao_s && tendencia_balde(t, i, idade, &b); idade++) {
+            fim_s -= n->duracao_s;
+            const ResumoQ8 *r = &b.canal[canal];
+            if (r->media == TENDENCIA_VAZIO) continue;
+            acumular(&p, de_q8(r->minimo), de_q8(r->media), de_q8(r->maximo), n->duracao_s, &soma, &segundos);
+        }
+    }
+    if (segundos) p.media = Q16_BRUTO(soma / segundos);
+    return p;
+}
+
+// Série de num_pontos pontos (do mais antigo ao mais recente) cobrindo os
+// últimos janela_s segundos em baldes fechados; cada ponto agrega os baldes
+// que caem nele. Retorna quantos pontos têm dados.
+uint32_t tendencia_serie(const Tendencia *t, uint8_t canal, uint32_t janela_s,
+                         PontoTendencia *pontos, uint32_t num_pontos) {
+    int nivel = tendencia_escolher_nivel(t, janela_s, num_pontos);
+    const NivelTendencia *n = &t->niveis[nivel];
+    uint32_t baldes = (janela_s + n->duracao_s - 1) / n->duracao_s;
+    if (baldes > n->capacidade) baldes = n->capacidade;
+    if (baldes == 0) baldes = 1;
+
+    memset(pontos, 0, num_pontos * sizeof(PontoTendencia));
+    int64_t soma = 0;
+    uint32_t num = 0;
+    uint32_t ponto_atual = num_pontos;
+    uint32_t validos = 0;
+
+    // Do mais antigo ao mais recente, fechando a média de cada ponto ao sair dele
+    for (uint32_t i = 0; i < baldes; i++) {
+        uint32_t idade = baldes - 1 - i;
+        uint32_t ponto = (uint32_t)(((uint64_t)i * num_pontos) / baldes);
+        if (ponto != ponto_atual) {
+            if (ponto_atual < num_pontos && num) {
+                pontos[ponto_atual].media = Q16_BRUTO(soma / num);
+                validos++;
+            }
+            ponto_atual = ponto;
+            soma = 0;
+            num = 0;
+        }
+        BaldeTendencia b;
+        if (!tendencia_balde(t, nivel, idade, &b)) continue;
+        const ResumoQ8 *r = &b.canal[canal];
+        if (r->media == TENDENCIA_VAZIO) continue;
+        acumular(&pontos[ponto], de_q8(r->minimo), de_q8(r->media), de_q8(r->maximo), 1, &soma, &num);
+    }
+    if (ponto_atual < num_pontos && num) {
+        pontos[ponto_atual].media = Q16_BRUTO(soma / num);
+        validos++;
+    }
+    return validos;
+}
@@ -0,0 +1,67 @@
+#ifndef TENDENCIA_H
+#define TENDENCIA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fixo.h"
+
+// Histórico de tendência em níveis de resolução: cada amostra entra, em
+// O(1), no balde aberto de cada nível (1 s, 10 s e 60 s), e o balde fechado
+// guarda mínimo, média e máximo de cada canal em Q8.8 num anel do nível. Os
+// três anéis cobrem 2 min, 30 min e 4 h em cerca de 6,5 KB. Segundos sem
+// amostras viram baldes vazios. Não depende do SDK.
+#define TENDENCIA_NUM_CANAIS 2
+#define TENDENCIA_NUM_NIVEIS 3
+#define TENDENCIA_TOTAL_BALDES (120 + 180 + 240)
+
+// Média de um balde sem amostras
+#define TENDENCIA_VAZIO INT16_MIN
+
+typedef struct {
+    int16_t minimo;     // Q8.8
+    int16_t media;
+    int16_t maximo;
+} ResumoQ8;
+
+typedef struct {
+    ResumoQ8 canal[TENDENCIA_NUM_CANAIS];
+} BaldeTendencia;
+
+typedef struct {
+    uint32_t duracao_s;
+    uint16_t capacidade;
+    BaldeTendencia *baldes;
+    uint16_t proximo;       // Onde entra o próximo balde fechado
+    uint16_t cheios;        // Baldes já fechados (até a capacidade)
+
+    // Balde aberto
+    uint32_t indice;        // Instante de início / duração
+    uint32_t amostras;
+    int64_t soma[TENDENCIA_NUM_CANAIS];
+    q16_t minimo[TENDENCIA_NUM_CANAIS];
+    q16_t maximo[TENDENCIA_NUM_CANAIS];
+} NivelTendencia;
+
+typedef struct {
+    NivelTendencia niveis[TENDENCIA_NUM_NIVEIS];
+    BaldeTendencia memoria[TENDENCIA_TOTAL_BALDES];
+    bool iniciado;
+} Tendencia;
+
+// Ponto de uma série ou resumo de uma janela, em Q16.16
+typedef struct {
+    q16_t minimo;
+    q16_t media;
+    q16_t maximo;
+    bool valido;
+} PontoTendencia;
+
+void tendencia_init(Tendencia *t);
+void tendencia_adicionar(Tendencia *t, uint64_t instante_us, const q16_t valores[TENDENCIA_NUM_CANAIS]);
+int tendencia_escolher_nivel(const Tendencia *t, uint32_t janela_s, uint32_t min_baldes);
+PontoTendencia tendencia_resumo(const Tendencia *t, uint8_t canal, uint32_t janela_s);
+uint32_t tendencia_serie(const Tendencia *t, uint8_t canal, uint32_t janela_s,
+                         PontoTendencia *pontos, uint32_t num_pontos);
+bool tendencia_balde(const Tendencia *t, int nivel, uint32_t idade, BaldeTendencia *balde);
+
+#endif
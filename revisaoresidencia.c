@@ -23,10 +23,29 @@
  #include "hardware/clocks.h"
  #include "include/ssd1306.h"    // Display OLED
  #include "include/font.h"       // Fonte para o OLED
+ #include "include/audio.h"       // Gerenciador de áudio (sons e feedback contínuo)
+ #include "include/aquisicao.h"   // Amostragem contínua do ADC via DMA
+ #include "include/ads1299.h"     // Front-end de biopotenciais via SPI
+ #include "include/fonte_simulada.h" // Dispositivo de aquisição simulado
+ #include "include/espectro.h"    // Potência por banda via FFT de ponto fixo
+ #include "include/biquad.h"      // Filtros de pré-processamento (notch, passa-faixa)
+ #include "include/gerador_eeg.h" // EEG sintético multibanda para demonstração
+ #include "include/prng.h"        // Gerador pseudoaleatório determinístico
+ #include "include/fixo.h"        // Ponto fixo Q16.16 (sem FPU no RP2040)
+ #include "include/artefato.h"    // Saturação, saltos e sinal plano por canal
+ #include "include/classificador.h" // Estado cognitivo com histerese e permanência
+ #include "include/estatistica.h" // Média, variância (Welford), mínimo e máximo online
+ #include "include/quantil.h"     // Mediana e percentis por histograma de memória fixa
+ #include "include/tempo_estado.h" // Tempo em cada estado e matriz de transições
+ #include "include/tendencia.h"   // Mínimo/média/máximo em baldes de 1 s, 10 s e 60 s
+ #include "include/dificuldade.h" // Alvos de treino adaptados ao desempenho recente
+ #include "include/sessoes.h"     // Registros das sessões de treino e melhores por objetivo
+ #include "include/metricas.h"    // Razões e índices das bandas, recalculados só quando mudam
+ #include "include/protocolo.h"   // Protocolos de treino como dados e o interpretador deles
+ #include "include/modelo_cognitivo.h" // Árvores de decisão treinadas fora do dispositivo
  #include "ws2812.pio.h"         // Matriz WS2812 via PIO
  #include <stdio.h>
  #include <string.h>
- #include <stdlib.h>
  #include <math.h>
  
  //===============================================
@@ -43,6 +62,29 @@
  #define POT_ATENCAO_PIN 27    // Simula EEG (foco/atenção)
  #define POT_RELAXAMENTO_PIN 26 // Simula GSR (relaxamento)
  
+ // Origem das amostras do pipeline
+ #define FONTE_POTENCIOMETROS 0  // ADC interno
+ #define FONTE_ADS1299 1         // Front-end de 4-8 canais via SPI (ads1299.h)
+ #define FONTE_SIMULADA 2        // Dispositivo simulado, sem hardware
+ #define FONTE_ENTRADA FONTE_POTENCIOMETROS
+ 
+ // Canais e taxa da fonte simulada (250, 500 ou 1000 Hz têm filtros projetados)
+ #define SIMULADA_NUM_CANAIS 4
+ #define SIMULADA_TAXA_HZ 500
+ 
+ // Papel de cada canal da fonte (índices; o ADC começa no GPIO 26)
+ #define CANAL_ATENCAO (POT_ATENCAO_PIN - 26)
+ #define CANAL_RELAXAMENTO (POT_RELAXAMENTO_PIN - 26)
+ #define CANAL_EEG CANAL_ATENCAO
+ 
+ // Derivação contralateral ao CANAL_EEG, usada só na assimetria alfa (-1 =
+ // nenhuma). Exige EEG real: com o gerador sintético ela fica desligada.
+ #if FONTE_ENTRADA == FONTE_POTENCIOMETROS
+ #define CANAL_EEG_PAR -1
+ #else
+ #define CANAL_EEG_PAR 2
+ #endif
+ 
  // Botões
  #define BUTTON_NEXT 5   // Avança (menu ou aumenta parâmetro)
  #define BUTTON_BACK 6   // Retrocede (menu ou diminui parâmetro)
@@ -58,6 +100,43 @@
  #define B_LED_PIN 12
  #define PWM_WRAP 255
  
+ // Frequência da rede elétrica a rejeitar (Brasil: 60 Hz)
+ #define FILTRO_REDE FILTRO_NOTCH_60HZ
+ 
+ // Substitui o canal de EEG pelo gerador sintético (sem eletrodos reais).
+ // Só os potenciômetros não trazem EEG; o ADS1299 e a fonte simulada já
+ // entregam o sinal no CANAL_EEG e ele não pode ser sobrescrito.
+ #define EEG_SINTETICO (FONTE_ENTRADA == FONTE_POTENCIOMETROS)
+ 
+ // Classifica com o modelo treinado (modelo_cognitivo_dados.h, gerado por
+ // tools/treinar_modelo.py) quando ele existe e está confiante; senão, e
+ // sempre com false, pela tabela de regiões. O modelo que acompanha o código
+ // vem desligado (MODELO_COGNITIVO_DISPONIVEL 0) até haver um treinado com
+ // sessões gravadas
+ #define CLASSIFICADOR_MODELO true
+ 
+ // Sem janela nova de características por mais que isto, o resultado do
+ // modelo expira e vale a tabela de regiões
+ #define MODELO_VALIDADE_US 1000000
+ 
+ // Sementes do ruído: fixas para que uma sessão possa ser reproduzida
+ #define SEMENTE_RUIDO_NIVEIS 0x4E53594Eu
+ #define SEMENTE_GERADOR_EEG  0x45454731u
+ #define SEMENTE_FONTE_SIMULADA 0x53494D31u
+ 
+ // Janela da FFT descartada quando mais amostras que isto foram marcadas como artefato
+ #define ARTEFATOS_MAX_JANELA (ESPECTRO_N / 10)
+ 
+ // A contagem de artefatos por salto da FFT soma blocos inteiros
+ #if ESPECTRO_SALTO % FONTE_QUADROS_BLOCO != 0
+ #error "ESPECTRO_SALTO deve ser múltiplo de FONTE_QUADROS_BLOCO"
+ #endif
+ 
+ // Cada objetivo de protocolo tem o seu agregado de sessões
+ #if SESSOES_NUM_OBJETIVOS != PROTOCOLO_NUM_OBJETIVOS
+ #error "SESSOES_NUM_OBJETIVOS deve ser igual a PROTOCOLO_NUM_OBJETIVOS"
+ #endif
+ 
  // Matriz WS2812
  #define NUM_PIXELS 25
  #define WS2812_PIN 7
@@ -78,34 +157,184 @@
  volatile int menu_index = 0;  // 0=Monitoramento, 1=Configuração, 2=Treinamento, 3=Histórico
  volatile bool in_set_mode = false;
  volatile int current_param = 0; // Parâmetro atual em configuração
+ 
+ // Páginas do modo de histórico, alternadas com SET
+ #define PAGINA_HISTORICO_MEDIAS 0
+ #define PAGINA_HISTORICO_ATENCAO 1      // Mediana, P10 e P90
+ #define PAGINA_HISTORICO_RELAXAMENTO 2
+ #define PAGINA_HISTORICO_ESTADOS 3      // Fração do tempo em cada estado
+ #define PAGINA_HISTORICO_TENDENCIA 4    // Gráfico da atenção nos últimos 30 min
+ #define PAGINA_HISTORICO_SESSOES 5      // Uma sessão por vez, SET passa à anterior
+ #define PAGINA_HISTORICO_MELHORES 6     // Melhor sessão de cada objetivo
+ #define NUM_PAGINAS_HISTORICO 7
+ volatile int pagina_historico = 0;
+ volatile uint32_t sessao_exibida = 0;   // Idade da sessão na página de sessões
+ 
+ // Parâmetros do modo de configuração (0-3 são os limiares)
+ #define PARAM_CALIBRACAO 4
+ #define PARAM_PERCENTIL_ALVO 5     // Dificuldade adaptativa do treino
+ #define PARAM_SUCESSO_MIN 6
+ #define PARAM_SUCESSO_MAX 7
+ #define NUM_PARAMETROS_CONFIG 8
  volatile uint32_t last_button_time = 0;
  const uint32_t DEBOUNCE_DELAY_MS = 200;
  
- // Estado cognitivo
+ // Estado cognitivo (Q16.16)
  typedef struct {
-     float atencao;      // 0-100%
-     float relaxamento;  // 0-10
-     float alpha;        // Ondas Alpha (8-12 Hz) - simulada
-     float beta;         // Ondas Beta (12-30 Hz) - simulada
-     float theta;        // Ondas Theta (4-8 Hz) - simulada
-     float delta;        // Ondas Delta (0.5-4 Hz) - simulada
+     q16_t atencao;      // 0-100%
+     q16_t relaxamento;  // 0-10
+     q16_t alpha;        // Ondas Alpha (8-12 Hz) - % da potência
+     q16_t beta;         // Ondas Beta (12-30 Hz) - % da potência
+     q16_t theta;        // Ondas Theta (4-8 Hz) - % da potência
+     q16_t delta;        // Ondas Delta (0.5-4 Hz) - % da potência
+     q16_t theta_beta;   // Razão theta/beta (suavizada)
+     q16_t engajamento;  // Beta / (alpha + theta) (suavizado)
+     q16_t assimetria;   // Alpha (par - EEG) / (par + EEG), -1 a 1; 0 sem derivação par
  } EstadoCognitivo;
  
  EstadoCognitivo estado_atual = {0};
  
- // Limiares e configurações
- volatile float limiar_atencao_baixo = 30.0f;
- volatile float limiar_atencao_alto = 70.0f;
- volatile float limiar_relaxamento_baixo = 3.0f;
- volatile float limiar_relaxamento_alto = 7.0f;
+ // Ruído das leituras de atenção e relaxamento
+ Prng prng_ruido;
+ 
+ // Fonte de canais em uso
+ const FonteCanais *fonte;
+ 
+ // Análise espectral do canal de EEG (simulado pelo potenciômetro de atenção)
+ Espectro espectro_eeg;
+ uint32_t tempo_fft_us = 0;      // Duração do último bloco
+ uint32_t tempo_fft_max_us = 0;  // Pior caso observado
+ 
+ // Pré-processamento por canal: o EEG passa por passa-altas (DC/deriva),
+ // notch da rede e passa-baixas antes da FFT; os níveis de atenção e
+ // relaxamento usam notch + passa-baixas lento, preservando o DC.
+ BiquadCascata filtro_eeg;
+ BiquadCascata filtro_nivel[FONTE_MAX_CANAIS];
+ bool filtros_iniciados = false;
+ uint32_t tempo_filtros_us = 0;  // Duração da filtragem do último bloco
+ 
+ // Calibração por canal aplicada na aquisição e a que está sendo capturada
+ CalibracaoCanal calibracao[FONTE_MAX_CANAIS];
+ CalibracaoCanal calibracao_nova[FONTE_MAX_CANAIS];
+ int etapa_calibracao = -1;  // Ponto em captura (PontoCalibracao); -1 = inativa
+ 
+ // Média filtrada do último bloco de cada canal (na faixa da fonte) e o
+ // instante de aquisição do último quadro dele
+ int32_t nivel_bloco[FONTE_MAX_CANAIS];
+ uint64_t instante_niveis_us = 0;
+ 
+ // Gerador de EEG sintético, com amplitudes por banda controladas pelos potenciômetros
+ GeradorEeg gerador_eeg;
+ uint32_t tempo_gerador_us = 0;  // Duração da geração do último bloco
+ 
+ // Detecção de artefatos antes da filtragem, com limites proporcionais à
+ // faixa da fonte. No EEG valem os três critérios; nos demais canais, cujos
+ // extremos e trechos parados são legítimos nos potenciômetros, só os saltos.
+ DetectorArtefato artefato_eeg;
+ DetectorArtefato artefato_nivel[FONTE_MAX_CANAIS];
+ uint32_t artefatos_salto_atual = 0;     // Amostras de EEG marcadas no salto em curso
+ uint32_t artefatos_salto_anterior = 0;
+ uint32_t janelas_descartadas = 0;
+ bool niveis_validos = false;            // Último bloco dos potenciômetros sem artefatos
+ 
+ // Métricas derivadas das bandas. Entradas: potência relativa (%) de cada
+ // banda do CANAL_EEG e a alfa da derivação par.
+ enum {
+     ENTRADA_DELTA = 0,
+     ENTRADA_THETA,
+     ENTRADA_ALPHA,
+     ENTRADA_BETA,
+     ENTRADA_ALPHA_PAR,
+ };
+ #define BIT_ENTRADA(e) (1u << (e))
+ MotorMetricas metricas;
+ int metrica_theta_beta, metrica_engajamento, metrica_assimetria;
+ uint32_t tempo_metricas_us = 0;         // Duração da última avaliação
+ 
+ // Classificação pelo modelo treinado: a última inferência, a duração dela
+ // e quantos ciclos usaram o modelo ou a tabela de regiões
+ bool caracteristicas_novas = false;     // Janela válida ainda não classificada
+ bool modelo_valido = false;
+ EstadoMental estado_modelo = ESTADO_NORMAL;
+ uint8_t confianca_modelo = 0;
+ uint64_t instante_modelo_us = 0;
+ uint32_t tempo_modelo_us = 0;
+ uint32_t tempo_modelo_max_us = 0;
+ uint32_t ciclos_modelo = 0;
+ uint32_t ciclos_regras = 0;
+ 
+ // Gravação dos vetores de características pela serial ('V'), com o rótulo
+ // definido pelos dígitos 0-5 ('-' volta a usar só o estado das regras)
+ bool gravar_vetores = false;
+ int rotulo_gravacao = -1;
+ 
+ // Fator da média exponencial das métricas (por janela da FFT)
+ #define SUAVIZACAO_METRICAS Q16_CONST(0.3)
+ 
+ #if CANAL_EEG_PAR >= 0
+ // Derivação par: mesmos artefatos, filtros e espectro do EEG principal
+ DetectorArtefato artefato_eeg_par;
+ BiquadCascata filtro_eeg_par;
+ Espectro espectro_eeg_par;
+ uint32_t artefatos_par_salto_atual = 0;
+ uint32_t artefatos_par_salto_anterior = 0;
+ #endif
+ 
+ // Limiares e configurações (Q16.16, mesmas escalas do EstadoCognitivo)
+ volatile q16_t limiar_atencao_baixo = Q16_INT(30);
+ volatile q16_t limiar_atencao_alto = Q16_INT(70);
+ volatile q16_t limiar_relaxamento_baixo = Q16_INT(3);
+ volatile q16_t limiar_relaxamento_alto = Q16_INT(7);
+ 
+ // Passos de ajuste dos limiares no modo de configuração
+ #define PASSO_LIMIAR_ATENCAO Q16_INT(5)
+ #define PASSO_LIMIAR_RELAXAMENTO Q16_CONST(0.5)
+ 
+ // Histerese abaixo de cada limiar e tempo mínimo para aceitar cada estado.
+ // Flow e ansiedade pedem mais tempo: mudam a carinha e disparam alertas.
+ const ConfigClassificador config_classificador = {
+     .histerese = {
+         [LIMIAR_ATENCAO_BAIXO] = Q16_INT(3),
+         [LIMIAR_ATENCAO_ALTO] = Q16_INT(3),
+         [LIMIAR_RELAXAMENTO_BAIXO] = Q16_CONST(0.3),
+         [LIMIAR_RELAXAMENTO_ALTO] = Q16_CONST(0.3),
+     },
+     .permanencia_min_us = {
+         [ESTADO_DISTRAIDO] = 400000,
+         [ESTADO_NORMAL] = 400000,
+         [ESTADO_CONCENTRADO] = 400000,
+         [ESTADO_RELAXADO] = 400000,
+         [ESTADO_FLOW] = 800000,
+         [ESTADO_ANSIOSO] = 800000,
+     },
+ };
+ ClassificadorCognitivo classificador;
+ 
+ // Carinha (0 = neutra, 1 = feliz, 2 = triste) e cor do LED RGB de cada estado
+ typedef struct {
+     uint8_t carinha;
+     uint8_t r, g, b;
+ } AparenciaEstado;
+ 
+ const AparenciaEstado aparencia_estado[NUM_ESTADOS_COGNITIVOS] = {
+     [ESTADO_DISTRAIDO]   = {2, 255, 255, 0},   // Triste, amarelo
+     [ESTADO_NORMAL]      = {0, 0, 0, 255},     // Neutra, azul
+     [ESTADO_CONCENTRADO] = {1, 0, 255, 0},     // Feliz, verde
+     [ESTADO_RELAXADO]    = {0, 0, 255, 255},   // Neutra, ciano
+     [ESTADO_FLOW]        = {1, 0, 255, 128},   // Feliz, verde-azulado
+     [ESTADO_ANSIOSO]     = {2, 255, 0, 0},     // Triste, vermelho
+ };
+ 
+ // Tela e LEDs do monitoramento precisam ser refeitos (outra tela os ocupou)
+ bool redesenhar_monitor = true;
  
  // Estatísticas para histórico
  typedef struct {
-     float soma_atencao;
-     float soma_relaxamento;
-     float max_atencao;
-     float max_relaxamento;
-     uint32_t amostras;
+     EstatisticaOnline atencao;
+     EstatisticaOnline relaxamento;
+     HistogramaQuantil dist_atencao;         // Distribuição para os quantis
+     HistogramaQuantil dist_relaxamento;
+     ContagemEstados estados;                // Tempo por estado e transições
      uint32_t tempo_inicio;
      uint32_t tempo_ultimo_treino;
      uint8_t sessoes_concluidas;
@@ -113,19 +342,124 @@
  
  Estatisticas stats = {0};
  
+ // Tendência de atenção e relaxamento (canais 0 e 1) para gráficos e exportação
+ #define TENDENCIA_CANAL_ATENCAO 0
+ #define TENDENCIA_CANAL_RELAXAMENTO 1
+ #define JANELA_GRAFICO_S (30 * 60)
+ Tendencia tendencia;
+ 
  // Dados de treinamento
  typedef struct {
-     uint8_t nivel_atual;    // Nível atual (1-10)
-     uint8_t nivel_maximo;   // Nível máximo alcançado
      uint32_t duracao;       // Duração em segundos
-     uint8_t objetivo;       // 0=Atenção, 1=Relaxamento, 2=Estado Flow
+     uint8_t protocolo;      // Índice do protocolo (embutidos, depois carregados)
      uint8_t status;         // 0=Não iniciado, 1=Em andamento, 2=Concluído, 3=Falha
-     uint32_t inicio;        // Tempo de início
-     uint32_t pontuacao;     // Pontuação acumulada
+     uint32_t inicio;        // Tempo de início em segundos (relógio de 64 bits)
+     ExecucaoProtocolo execucao;     // Fase, nível, pontuação e tempo no alvo
+     uint64_t instante_pontuado_us;  // Até onde o tempo de aquisição já foi avaliado
  } DadosTreinamento;
  
+ // A pontuação vem do tempo no alvo medido pelos carimbos da aquisição, e não
+ // das iterações do loop: um ponto a cada PROTOCOLO_MS_POR_PONTO no alvo.
+ // Intervalos maiores que o limite (fonte parada ou reiniciada) só contam até ele.
+ #define INTERVALO_CREDITO_MAX_US 500000
+ 
+ // Protocolos embutidos (flash). Os três primeiros são os objetivos
+ // originais: alvo adaptativo, 9 níveis de 50 pontos em até 5 minutos. O
+ // de theta/beta tem objetivo próprio, com melhor sessão separada.
+ #define RECOMPENSAS_PADRAO (RECOMPENSA_SONIFICACAO | RECOMPENSA_SOM_NIVEL)
+ static const Protocolo protocolos_embutidos[] = {
+     {
+         .nome = "Atencao", .objetivo = 0, .num_fases = 1,
+         .fases = {
+             {.condicoes = {{SINAL_ATENCAO, REGRA_ALVO}}, .duracao_s = 300, .niveis = 9,
+              .recompensas = RECOMPENSAS_PADRAO, .pontos_por_nivel = 50},
+         },
+     },
+     {
+         .nome = "Relaxamento", .objetivo = 1, .num_fases = 1,
+         .fases = {
+             {.condicoes = {{SINAL_RELAXAMENTO, REGRA_ALVO}}, .duracao_s = 300, .niveis = 9,
+              .recompensas = RECOMPENSAS_PADRAO, .pontos_por_nivel = 50},
+         },
+     },
+     {
+         .nome = "Estado Flow", .objetivo = 2, .num_fases = 1,
+         .fases = {
+             {.condicoes = {{SINAL_ATENCAO, REGRA_ALVO}, {SINAL_RELAXAMENTO, REGRA_ALVO}},
+              .duracao_s = 300, .niveis = 9, .recompensas = RECOMPENSAS_PADRAO, .pontos_por_nivel = 50},
+         },
+     },
+     {
+         // Linha de base em silêncio e redução da razão theta/beta
+         .nome = "Theta/Beta", .objetivo = 3, .num_fases = 2,
+         .fases = {
+             {.duracao_s = 30},
+             {.condicoes = {{SINAL_THETA_BETA, REGRA_ABAIXO, Q16_CONST(1.5)}}, .duracao_s = 600, .niveis = 9,
+              .recompensas = RECOMPENSAS_PADRAO | RECOMPENSA_SOM_FASE, .pontos_por_nivel = 50},
+         },
+     },
+ };
+ #define NUM_PROTOCOLOS_EMBUTIDOS (sizeof(protocolos_embutidos) / sizeof(protocolos_embutidos[0]))
+ 
+ // Protocolos recebidos pela serial (RAM; um nome repetido substitui o anterior)
+ #define MAX_PROTOCOLOS_CARREGADOS 4
+ Protocolo protocolos_carregados[MAX_PROTOCOLOS_CARREGADOS];
+ uint32_t num_protocolos_carregados = 0;
+ uint32_t proximo_protocolo_carregado = 0;
+ 
+ // Duração do último passo do interpretador e o pior caso
+ uint32_t tempo_protocolo_us = 0;
+ uint32_t tempo_protocolo_max_us = 0;
+ 
+ // Alvos adaptativos do treino: partem dos limiares altos e seguem o
+ // percentil das médias recentes (mais alto a cada nível), mantendo a taxa
+ // de sucesso na faixa. Os percentuais são ajustados no modo de configuração.
+ volatile ConfigDificuldade config_dificuldade = {
+     .percentil_base = 50,
+     .percentil_por_nivel = 4,
+     .sucesso_min = 40,
+     .sucesso_max = 70,
+ };
+ #define PASSO_PERCENTUAL_DIFICULDADE 5
+ Dificuldade dificuldade_atencao;
+ Dificuldade dificuldade_relaxamento;
+ 
+ // Sessões de treino encerradas e o tempo por estado da sessão em andamento
+ HistoricoSessoes sessoes;
+ ContagemEstados estados_sessao;
+ 
  DadosTreinamento treinamento = {0};
  
+ static inline uint32_t num_protocolos(void) {
+     return NUM_PROTOCOLOS_EMBUTIDOS + num_protocolos_carregados;
+ }
+ 
+ static inline const Protocolo *obter_protocolo(uint32_t indice) {
+     if (indice < NUM_PROTOCOLOS_EMBUTIDOS) return &protocolos_embutidos[indice];
+     return &protocolos_carregados[indice - NUM_PROTOCOLOS_EMBUTIDOS];
+ }
+ 
+ // Sinais que esta build consegue produzir: a assimetria exige a derivação
+ // par de EEG real
+ static uint32_t sinais_disponiveis(void) {
+     uint32_t disponiveis = PROTOCOLO_BIT_SINAL(SINAL_ATENCAO) | PROTOCOLO_BIT_SINAL(SINAL_RELAXAMENTO) |
+                            PROTOCOLO_BIT_SINAL(SINAL_THETA_BETA) | PROTOCOLO_BIT_SINAL(SINAL_ENGAJAMENTO);
+ #if CANAL_EEG_PAR >= 0
+     if (!EEG_SINTETICO && CANAL_EEG_PAR < fonte->num_canais) disponiveis |= PROTOCOLO_BIT_SINAL(SINAL_ASSIMETRIA);
+ #endif
+     return disponiveis;
+ }
+ 
+ // Sinais com valor agora: atenção e relaxamento sempre, as métricas só
+ // depois da primeira avaliação
+ static uint32_t sinais_validos(void) {
+     uint32_t validos = PROTOCOLO_BIT_SINAL(SINAL_ATENCAO) | PROTOCOLO_BIT_SINAL(SINAL_RELAXAMENTO);
+     if (metricas_valida(&metricas, metrica_theta_beta)) validos |= PROTOCOLO_BIT_SINAL(SINAL_THETA_BETA);
+     if (metricas_valida(&metricas, metrica_engajamento)) validos |= PROTOCOLO_BIT_SINAL(SINAL_ENGAJAMENTO);
+     if (metricas_valida(&metricas, metrica_assimetria)) validos |= PROTOCOLO_BIT_SINAL(SINAL_ASSIMETRIA);
+     return validos;
+ }
+ 
  //===============================================
  // Padrões visuais para a matriz de LEDs (5x5)
  //===============================================
@@ -270,182 +604,415 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
  //===============================================
  // Funções para feedback sonoro
  //===============================================
- 
- // Gera um tom no buzzer (bloqueante)
- void play_tone(uint gpio, int frequency, int duration_ms) {
-     uint slice_num = pwm_gpio_to_slice_num(gpio);
-     uint channel = pwm_gpio_to_channel(gpio);
-     gpio_set_function(gpio, GPIO_FUNC_PWM);
-     float divider = 1.0f;
-     uint32_t wrap = (uint32_t)((125000000.0f / (divider * frequency)) - 1);
-     pwm_set_clkdiv(slice_num, divider);
-     pwm_set_wrap(slice_num, wrap);
-     pwm_set_chan_level(slice_num, channel, (wrap + 1) / 2);
-     pwm_set_enabled(slice_num, true);
-     sleep_ms(duration_ms);
-     pwm_set_enabled(slice_num, false);
-     gpio_set_function(gpio, GPIO_FUNC_SIO);
-     gpio_set_dir(gpio, GPIO_OUT);
-     gpio_put(gpio, 0);
- }
- 
- // Callback para parar o tom (não bloqueante)
- int64_t stop_tone_callback(alarm_id_t id, void *user_data) {
-     uint gpio = *(uint*)user_data;
-     uint slice_num = pwm_gpio_to_slice_num(gpio);
-     pwm_set_enabled(slice_num, false);
-     gpio_set_function(gpio, GPIO_FUNC_SIO);
-     gpio_set_dir(gpio, GPIO_OUT);
-     gpio_put(gpio, 0);
-     free(user_data);
-     return 0;
- }
- 
- // Toca um tom de forma não bloqueante
- void play_tone_non_blocking(uint gpio, int frequency, int duration_ms) {
-     uint slice_num = pwm_gpio_to_slice_num(gpio);
-     uint channel = pwm_gpio_to_channel(gpio);
-     gpio_set_function(gpio, GPIO_FUNC_PWM);
-     float divider = 1.0f;
-     uint32_t wrap = (uint32_t)((125000000.0f / (divider * frequency)) - 1);
-     pwm_set_clkdiv(slice_num, divider);
-     pwm_set_wrap(slice_num, wrap);
-     pwm_set_chan_level(slice_num, channel, (wrap + 1) / 2);
-     pwm_set_enabled(slice_num, true);
-     uint *gpio_ptr = malloc(sizeof(uint));
-     *gpio_ptr = gpio;
-     add_alarm_in_ms(duration_ms, stop_tone_callback, gpio_ptr, false);
- }
+ // Os pedidos vão para a fila do gerenciador de áudio, que arbitra as duas
+ // vozes por prioridade (alerta > sucesso > feedback > bipe de interface).
+ // Nenhuma delas bloqueia, então podem ser chamadas de ISRs.
  
  // Reproduz uma sequência de tons indicando sucesso
  void tocar_sucesso() {
-     play_tone_non_blocking(BUZZER1_PIN, 523, 200); // Do
-     sleep_ms(220);
-     play_tone_non_blocking(BUZZER1_PIN, 659, 200); // Mi
-     sleep_ms(220);
-     play_tone_non_blocking(BUZZER1_PIN, 784, 400); // Sol
+     audio_solicitar(AUDIO_SOM_SUCESSO); // Do-Mi-Sol
  }
  
  // Reproduz uma sequência de tons indicando erro
  void tocar_erro() {
-     play_tone_non_blocking(BUZZER2_PIN, 440, 200); // Lá
-     sleep_ms(250);
-     play_tone_non_blocking(BUZZER2_PIN, 349, 400); // Fá
+     audio_solicitar(AUDIO_SOM_ERRO); // Lá-Fá
  }
  
  // Reproduz um bipe básico para indicação
  void beep() {
-     play_tone_non_blocking(BUZZER2_PIN, 392, 100); // Sol
+     audio_solicitar(AUDIO_SOM_BIPE); // Sol
  }
  
  //===============================================
  // Funções para simulação de ondas cerebrais
  //===============================================
  
+ // Fatores de escala da amostra para os níveis em Q16.16, calculados uma
+ // vez para a faixa da fonte: nível = ((amostra - mínimo) * fator) >> 16
+ uint32_t fator_atencao;
+ uint32_t fator_relaxamento;
+ 
  // Obtém o nível de atenção simulado a partir do potenciômetro X
- float obter_nivel_atencao(uint16_t adc_valor) {
-     // Adiciona pequena variação aleatória para simular flutuações naturais
-     float ruido = ((float)rand() / RAND_MAX) * 5.0f - 2.5f; // ±2.5% de ruído
-     float valor = (adc_valor / 4095.0f) * 100.0f + ruido;
+ // (amostra na faixa da fonte)
+ q16_t obter_nivel_atencao(int32_t amostra) {
+     // Ruído gaussiano com desvio de 1.25% para simular flutuações naturais
+     // (gaussiano Q12 * 20 = desvio de 1.25 em Q16)
+     uint32_t deslocada = (uint32_t)(amostra - fonte->minimo);
+     q16_t valor = Q16_BRUTO((((uint64_t)deslocada * fator_atencao) >> 16)
+                             + prng_gaussiano_q12(&prng_ruido) * 20);
      
      // Limita entre 0-100%
-     if (valor < 0.0f) valor = 0.0f;
-     if (valor > 100.0f) valor = 100.0f;
-     
-     return valor;
+     return q16_limitar(valor, Q16_ZERO, Q16_INT(100));
  }
  
  // Obtém o nível de relaxamento simulado a partir do potenciômetro Y
- float obter_nivel_relaxamento(uint16_t adc_valor) {
-     // Adiciona pequena variação aleatória para simular flutuações naturais
-     float ruido = ((float)rand() / RAND_MAX) * 0.5f - 0.25f; // ±0.25 de ruído
-     float valor = (adc_valor / 4095.0f) * 10.0f + ruido;
+ q16_t obter_nivel_relaxamento(int32_t amostra) {
+     // Ruído gaussiano com desvio de 0.125
+     uint32_t deslocada = (uint32_t)(amostra - fonte->minimo);
+     q16_t valor = Q16_BRUTO((((uint64_t)deslocada * fator_relaxamento) >> 16)
+                             + prng_gaussiano_q12(&prng_ruido) * 2);
      
      // Limita entre 0-10
-     if (valor < 0.0f) valor = 0.0f;
-     if (valor > 10.0f) valor = 10.0f;
+     return q16_limitar(valor, Q16_ZERO, Q16_INT(10));
+ }
+ 
+ // Ajusta as amplitudes do EEG sintético conforme atenção e relaxamento
+ // (em unidades do ADC de 16 bits)
+ void atualizar_gerador_eeg(EstadoCognitivo *estado) {
+     // Atenção alta = mais ondas beta, menos theta
+     q16_t beta = q16_somar(Q16_INT(10), q16_escalar(estado->atencao, 1, 5));          // 10 + at/100 * 20
+     q16_t theta = q16_subtrair(Q16_INT(20), q16_escalar(estado->atencao, 3, 20));    // 20 - at/100 * 15
+     
+     // Relaxamento alto = mais ondas alpha
+     q16_t alpha = q16_somar(Q16_INT(5), estado->relaxamento);                        // 5 + rx/10 * 10
+     
+     // Delta aumenta quando atenção e relaxamento são baixos:
+     // 20 - 18 * (at/100 + rx/10) / 2
+     q16_t delta = q16_subtrair(q16_subtrair(Q16_INT(20), q16_escalar(estado->atencao, 9, 100)),
+                                q16_escalar(estado->relaxamento, 9, 10));
      
-     return valor;
+     gerador_eeg_definir_amplitude(&gerador_eeg, BANDA_BETA, (uint16_t)q16_para_int(q16_escalar(beta, 50, 1)));
+     gerador_eeg_definir_amplitude(&gerador_eeg, BANDA_THETA, (uint16_t)q16_para_int(q16_escalar(theta, 50, 1)));
+     gerador_eeg_definir_amplitude(&gerador_eeg, BANDA_ALPHA, (uint16_t)q16_para_int(q16_escalar(alpha, 50, 1)));
+     gerador_eeg_definir_amplitude(&gerador_eeg, BANDA_DELTA, (uint16_t)q16_para_int(q16_escalar(delta, 50, 1)));
+ }
+ 
+ // Preenche as ondas cerebrais com a potência relativa de cada banda
+ void atualizar_ondas_cerebrais(EstadoCognitivo *estado, const ResultadoBandas *bandas) {
+     // Décimos de % para % em Q16.16
+     estado->delta = q16_fracao(bandas->relativa[BANDA_DELTA], 10);
+     estado->theta = q16_fracao(bandas->relativa[BANDA_THETA], 10);
+     estado->alpha = q16_fracao(bandas->relativa[BANDA_ALPHA], 10);
+     estado->beta = q16_fracao(bandas->relativa[BANDA_BETA], 10);
+     
+     caracteristicas_novas = true;
+     
+     // Só as bandas que mudaram sujam as métricas que dependem delas
+     metricas_definir_entrada(&metricas, ENTRADA_DELTA, estado->delta);
+     metricas_definir_entrada(&metricas, ENTRADA_THETA, estado->theta);
+     metricas_definir_entrada(&metricas, ENTRADA_ALPHA, estado->alpha);
+     metricas_definir_entrada(&metricas, ENTRADA_BETA, estado->beta);
  }
  
- // Simula as ondas cerebrais com base nos níveis de atenção e relaxamento
- void simular_ondas_cerebrais(EstadoCognitivo *estado) {
-     // Aqui simulamos uma relação entre os valores dos potenciômetros e as ondas cerebrais
-     // Estes são modelos simplificados para fins educativos
+ // Registra as métricas derivadas das bandas
+ void iniciar_metricas() {
+     static const ExpressaoMetrica theta_beta = {
+         .numerador = BIT_ENTRADA(ENTRADA_THETA),
+         .denominador = BIT_ENTRADA(ENTRADA_BETA),
+     };
+     static const ExpressaoMetrica engajamento = {
+         .numerador = BIT_ENTRADA(ENTRADA_BETA),
+         .denominador = BIT_ENTRADA(ENTRADA_ALPHA) | BIT_ENTRADA(ENTRADA_THETA),
+     };
+     static const ExpressaoMetrica assimetria = {
+         .numerador = BIT_ENTRADA(ENTRADA_ALPHA_PAR),
+         .subtraendo = BIT_ENTRADA(ENTRADA_ALPHA),
+         .denominador = BIT_ENTRADA(ENTRADA_ALPHA_PAR) | BIT_ENTRADA(ENTRADA_ALPHA),
+     };
+     metricas_init(&metricas);
+     metrica_theta_beta = metricas_registrar(&metricas, "Theta/Beta", &theta_beta, SUAVIZACAO_METRICAS);
+     metrica_engajamento = metricas_registrar(&metricas, "Engajamento", &engajamento, SUAVIZACAO_METRICAS);
+     metrica_assimetria = metricas_registrar(&metricas, "Assimetria", &assimetria, SUAVIZACAO_METRICAS);
+ }
+ 
+ // Recalcula as métricas com entradas novas e as copia para o estado
+ void atualizar_metricas(EstadoCognitivo *estado) {
+     uint32_t inicio = time_us_32();
+     if (!metricas_avaliar(&metricas)) return;
+     tempo_metricas_us = time_us_32() - inicio;
+     estado->theta_beta = metricas_valor(&metricas, metrica_theta_beta);
+     estado->engajamento = metricas_valor(&metricas, metrica_engajamento);
+     estado->assimetria = metricas_valor(&metricas, metrica_assimetria);
+ }
+ 
+ // Vetor de características para o treino do modelo (tools/treinar_modelo.py)
+ void imprimir_vetor(const q16_t c[MODELO_NUM_CARACTERISTICAS], EstadoMental regras) {
+     printf("VETOR,%lu", (unsigned long)(instante_niveis_us / 1000));
+     for (int i = 0; i < MODELO_NUM_CARACTERISTICAS; i++) {
+         printf(",%.4f", q16_para_float(c[i]));
+     }
+     printf(",%d,%d\n", (int)regras, rotulo_gravacao);
+ }
+ 
+ // Classifica o estado cognitivo no tempo da aquisição; retorna true quando
+ // uma transição é aceita. Cada janela nova de características passa pelo
+ // modelo treinado; sem modelo, com confiança baixa ou sem janela recente
+ // valem os limiares atuais na tabela de regiões.
+ bool determinar_estado_cognitivo(EstadoCognitivo *estado, EventoTransicao *evento) {
+     const q16_t limiares[NUM_LIMIARES] = {
+         [LIMIAR_ATENCAO_BAIXO] = limiar_atencao_baixo,
+         [LIMIAR_ATENCAO_ALTO] = limiar_atencao_alto,
+         [LIMIAR_RELAXAMENTO_BAIXO] = limiar_relaxamento_baixo,
+         [LIMIAR_RELAXAMENTO_ALTO] = limiar_relaxamento_alto,
+     };
+     
+     if (caracteristicas_novas) {
+         caracteristicas_novas = false;
+         const q16_t c[MODELO_NUM_CARACTERISTICAS] = {
+             [CARAC_ATENCAO] = estado->atencao,
+             [CARAC_RELAXAMENTO] = estado->relaxamento,
+             [CARAC_DELTA] = estado->delta,
+             [CARAC_THETA] = estado->theta,
+             [CARAC_ALPHA] = estado->alpha,
+             [CARAC_BETA] = estado->beta,
+             [CARAC_THETA_BETA] = estado->theta_beta,
+             [CARAC_ENGAJAMENTO] = estado->engajamento,
+         };
+         if (gravar_vetores) {
+             imprimir_vetor(c, classificador_regiao(estado->atencao, estado->relaxamento, limiares));
+         }
+         if (CLASSIFICADOR_MODELO && modelo_disponivel()) {
+             uint32_t inicio = time_us_32();
+             modelo_valido = modelo_classificar(c, &estado_modelo, &confianca_modelo);
+             tempo_modelo_us = time_us_32() - inicio;
+             if (tempo_modelo_us > tempo_modelo_max_us) tempo_modelo_max_us = tempo_modelo_us;
+             instante_modelo_us = instante_niveis_us;
+         }
+     }
      
-     // Atenção alta = mais ondas beta, menos theta
-     estado->beta = 10.0f + (estado->atencao / 100.0f) * 20.0f;
-     estado->theta = 20.0f - (estado->atencao / 100.0f) * 15.0f;
-     
-     // Relaxamento alto = mais ondas alpha, menos beta
-     estado->alpha = 5.0f + (estado->relaxamento / 10.0f) * 10.0f;
-     
-     // Delta é mais associado ao sono profundo
-     // Aumenta quando ambos atenção e relaxamento são baixos
-     float media_ativacao = (estado->atencao/100.0f + estado->relaxamento/10.0f) / 2.0f;
-     estado->delta = 20.0f - media_ativacao * 18.0f;
-     
-     // Garantir que todos os valores estejam em faixas razoáveis
-     if (estado->beta < 0.0f) estado->beta = 0.0f;
-     if (estado->alpha < 0.0f) estado->alpha = 0.0f;
-     if (estado->theta < 0.0f) estado->theta = 0.0f;
-     if (estado->delta < 0.0f) estado->delta = 0.0f;
+     // As zonas acompanham os níveis também quando o modelo decide, para a
+     // tabela de regiões retomar com a histerese em dia quando ele expirar
+     EstadoMental regiao = classificador_atualizar_zonas(&classificador, estado->atencao, estado->relaxamento,
+                                                         limiares);
+     if (modelo_valido && instante_niveis_us - instante_modelo_us <= MODELO_VALIDADE_US) {
+         ciclos_modelo++;
+         return classificador_aceitar(&classificador, estado_modelo, instante_niveis_us, evento);
+     }
+     ciclos_regras++;
+     return classificador_aceitar(&classificador, regiao, instante_niveis_us, evento);
  }
  
- // Determina o estado cognitivo global com base nos parâmetros
- int determinar_estado_cognitivo(EstadoCognitivo *estado) {
-     /*
-     Estados:
-     0 = Atenção Baixa / Distraído
-     1 = Atenção Normal
-     2 = Alta Concentração
-     3 = Relaxamento Profundo
-     4 = Estado Flow (Atenção Alta + Relaxamento Alto)
-     5 = Ansiedade (Atenção Alta + Relaxamento Muito Baixo)
-     */
-     
-     if (estado->atencao >= limiar_atencao_alto && estado->relaxamento >= limiar_relaxamento_alto) {
-         return 4; // Estado Flow
-     } else if (estado->atencao >= limiar_atencao_alto && estado->relaxamento < limiar_relaxamento_baixo) {
-         return 5; // Ansiedade
-     } else if (estado->atencao >= limiar_atencao_alto) {
-         return 2; // Alta Concentração
-     } else if (estado->atencao < limiar_atencao_baixo) {
-         return 0; // Distraído
-     } else if (estado->relaxamento >= limiar_relaxamento_alto) {
-         return 3; // Relaxamento Profundo
-     } else {
-         return 1; // Estado Normal
+ // Estatísticas, quantis e tendência recebem cada bloco válido uma vez, com
+ // o instante dele, qualquer que seja o ritmo do loop da interface
+ void acumular_estatisticas(q16_t atencao, q16_t relaxamento, uint64_t instante_us) {
+     estatistica_adicionar(&stats.atencao, atencao);
+     estatistica_adicionar(&stats.relaxamento, relaxamento);
+     quantil_adicionar(&stats.dist_atencao, atencao);
+     quantil_adicionar(&stats.dist_relaxamento, relaxamento);
+     const q16_t valores_tendencia[TENDENCIA_NUM_CANAIS] = {
+         [TENDENCIA_CANAL_ATENCAO] = atencao,
+         [TENDENCIA_CANAL_RELAXAMENTO] = relaxamento,
+     };
+     tendencia_adicionar(&tendencia, instante_us, valores_tendencia);
+ }
+ 
+ // Drena o anel da fonte em blocos de FONTE_QUADROS_BLOCO quadros, tratados
+ // no próprio anel (sem cópia) antes de devolvê-los ao produtor: todas as
+ // amostras do canal de EEG alimentam a análise espectral, e atenção e
+ // relaxamento usam a média do bloco mais recente. A taxa de amostragem
+ // independe deste loop. Todos os canais passam pelo mesmo tratamento,
+ // qualquer que seja o número deles. Com acumular, cada bloco sem
+ // artefatos entra nas estatísticas do monitoramento.
+ void atualizar_niveis_sensores(bool acumular) {
+     static int32_t eeg[FONTE_QUADROS_BLOCO];
+     AnelQuadros *anel = fonte->anel;
+     uint32_t num_canais = fonte->num_canais;
+     bool novo = false;
+ #if CANAL_EEG_PAR >= 0
+     static int32_t eeg_par[FONTE_QUADROS_BLOCO];
+     bool usar_par = !EEG_SINTETICO && CANAL_EEG_PAR < num_canais;
+ #endif
+     
+     if (fonte->produzir) fonte->produzir();
+     
+     // O consumidor avança sempre em blocos inteiros e a capacidade é múltipla
+     // do bloco, então o trecho contíguo nunca é cortado no fim do anel
+     while (anel_ocupacao(anel) >= FONTE_QUADROS_BLOCO) {
+         QuadroAmostras *q;
+         uint32_t num = anel_trecho(anel, &q, FONTE_QUADROS_BLOCO);
+         novo = true;
+         
+         for (uint32_t i = 0; i < num; i++) {
+             eeg[i] = q[i].canais[CANAL_EEG];
+         }
+         
+         // O sinal sintético entra na mesma taxa e no mesmo ponto que um sensor real
+         if (EEG_SINTETICO) {
+             uint32_t inicio_gerador = time_us_32();
+             gerador_eeg_gerar(&gerador_eeg, eeg, num, 1);
+             tempo_gerador_us = time_us_32() - inicio_gerador;
+         }
+         
+         // Amostras com artefato são retidas no último valor válido antes dos filtros
+         niveis_validos = true;
+         for (uint32_t c = 0; c < num_canais; c++) {
+             if (artefato_processar_bloco(&artefato_nivel[c], &q[0].canais[c], num, QUADRO_PASSO)) {
+                 niveis_validos = false;
+             }
+         }
+         artefatos_salto_atual += artefato_processar_bloco(&artefato_eeg, eeg, num, 1);
+ #if CANAL_EEG_PAR >= 0
+         if (usar_par) {
+             for (uint32_t i = 0; i < num; i++) {
+                 eeg_par[i] = q[i].canais[CANAL_EEG_PAR];
+             }
+             artefatos_par_salto_atual += artefato_processar_bloco(&artefato_eeg_par, eeg_par, num, 1);
+         }
+ #endif
+         
+         // Parte do regime permanente com a primeira amostra
+         if (!filtros_iniciados) {
+             for (uint32_t c = 0; c < num_canais; c++) {
+                 biquad_cascata_reiniciar(&filtro_nivel[c], q[0].canais[c]);
+             }
+             biquad_cascata_reiniciar(&filtro_eeg, eeg[0]);
+ #if CANAL_EEG_PAR >= 0
+             if (usar_par) biquad_cascata_reiniciar(&filtro_eeg_par, eeg_par[0]);
+ #endif
+             filtros_iniciados = true;
+         }
+         
+         uint32_t inicio_filtros = time_us_32();
+         for (uint32_t c = 0; c < num_canais; c++) {
+             biquad_processar_bloco(&filtro_nivel[c], &q[0].canais[c], num, QUADRO_PASSO);
+         }
+         biquad_processar_bloco(&filtro_eeg, eeg, num, 1);
+ #if CANAL_EEG_PAR >= 0
+         if (usar_par) biquad_processar_bloco(&filtro_eeg_par, eeg_par, num, 1);
+ #endif
+         tempo_filtros_us = time_us_32() - inicio_filtros;
+         
+         for (uint32_t i = 0; i < num; i++) {
+             if (espectro_adicionar(&espectro_eeg, eeg[i])) {
+                 ResultadoBandas bandas;
+                 uint32_t inicio = time_us_32();
+                 espectro_calcular(&espectro_eeg, &bandas);
+                 tempo_fft_us = time_us_32() - inicio;
+                 if (tempo_fft_us > tempo_fft_max_us) tempo_fft_max_us = tempo_fft_us;
+                 
+                 // A janela cobre o salto atual e o anterior
+                 if (artefatos_salto_atual + artefatos_salto_anterior <= ARTEFATOS_MAX_JANELA) {
+                     atualizar_ondas_cerebrais(&estado_atual, &bandas);
+                 } else {
+                     janelas_descartadas++;
+                 }
+                 artefatos_salto_anterior = artefatos_salto_atual;
+                 artefatos_salto_atual = 0;
+             }
+ #if CANAL_EEG_PAR >= 0
+             // Mesmo salto do EEG principal: as janelas das duas derivações coincidem
+             if (usar_par && espectro_adicionar(&espectro_eeg_par, eeg_par[i])) {
+                 ResultadoBandas bandas;
+                 espectro_calcular(&espectro_eeg_par, &bandas);
+                 if (artefatos_par_salto_atual + artefatos_par_salto_anterior <= ARTEFATOS_MAX_JANELA) {
+                     metricas_definir_entrada(&metricas, ENTRADA_ALPHA_PAR,
+                                              q16_fracao(bandas.relativa[BANDA_ALPHA], 10));
+                 }
+                 artefatos_par_salto_anterior = artefatos_par_salto_atual;
+                 artefatos_par_salto_atual = 0;
+             }
+ #endif
+         }
+         
+         // A média sai antes de devolver os quadros: depois disso o produtor
+         // pode sobrescrevê-los
+         for (uint32_t c = 0; c < num_canais; c++) {
+             int32_t soma = 0;
+             for (uint32_t i = 0; i < num; i++) {
+                 soma += q[i].canais[c];
+             }
+             
+             // Limita à faixa da fonte (o filtro pode ultrapassar levemente nos extremos)
+             int32_t media = soma / (int32_t)num;
+             if (media < fonte->minimo) media = fonte->minimo;
+             if (media > fonte->maximo) media = fonte->maximo;
+             nivel_bloco[c] = media;
+         }
+         instante_niveis_us = q[num - 1].instante_us;
+         
+         anel_consumir(anel, num);
+         
+         estado_atual.atencao = obter_nivel_atencao(nivel_bloco[CANAL_ATENCAO]);
+         estado_atual.relaxamento = obter_nivel_relaxamento(nivel_bloco[CANAL_RELAXAMENTO]);
+         if (acumular && niveis_validos) {
+             acumular_estatisticas(estado_atual.atencao, estado_atual.relaxamento, instante_niveis_us);
+         }
+     }
+     if (!novo) return;
+     
+     atualizar_metricas(&estado_atual);
+     
+     if (EEG_SINTETICO) {
+         atualizar_gerador_eeg(&estado_atual);
      }
  }
  
  //===============================================
- // Funções do Display OLED
+ // Calibração dos potenciômetros
  //===============================================
  
- // Atualiza o display no modo de monitoramento
- void atualizar_display_monitoramento(ssd1306_t *ssd, EstadoCognitivo *estado, int estado_cognitivo) {
-     char linha1[32], linha2[32], linha3[32];
+ // Começa (ou recomeça) a captura: a fonte passa a entregar as amostras
+ // brutas, e os pontos são capturados com os dois potenciômetros juntos.
+ // Só vale para fontes que aceitam tabelas (o ADC interno).
+ void iniciar_calibracao() {
+     if (!fonte->definir_calibracao) return;
+     for (int c = 0; c < fonte->num_canais; c++) {
+         fonte->definir_calibracao(c, NULL);
+     }
+     etapa_calibracao = CALIBRACAO_PONTO_MIN;
+ }
+ 
+ // Encerra a captura e volta a aplicar a calibração vigente
+ void cancelar_calibracao() {
+     if (!fonte->definir_calibracao) return;
+     for (int c = 0; c < fonte->num_canais; c++) {
+         fonte->definir_calibracao(c, &calibracao[c]);
+     }
+     etapa_calibracao = -1;
+ }
+ 
+ // Registra a média atual de cada canal como o ponto em captura. Após o
+ // máximo, as tabelas válidas substituem as vigentes; um canal com curso
+ // insuficiente ou pontos fora de ordem mantém a calibração anterior.
+ void capturar_ponto_calibracao() {
+     if (etapa_calibracao < 0) return;
+     
+     for (int c = 0; c < fonte->num_canais; c++) {
+         calibracao_definir_ponto(&calibracao_nova[c], etapa_calibracao, (uint16_t)nivel_bloco[c]);
+     }
+     
+     if (++etapa_calibracao < CALIBRACAO_NUM_PONTOS) return;
+     
+     bool todos_validos = true;
+     for (int c = 0; c < fonte->num_canais; c++) {
+         if (calibracao_construir(&calibracao_nova[c], (uint16_t)fonte->maximo)) {
+             calibracao[c] = calibracao_nova[c];
+         } else {
+             todos_validos = false;
+         }
+     }
+     cancelar_calibracao();
      
-     // Determina o nome do estado cognitivo
-     const char *estado_nome;
-     switch (estado_cognitivo) {
-         case 0: estado_nome = "Distraido"; break;
-         case 1: estado_nome = "Normal"; break;
-         case 2: estado_nome = "Concentrado"; break;
-         case 3: estado_nome = "Relaxado"; break;
-         case 4: estado_nome = "Estado Flow"; break;
-         case 5: estado_nome = "Ansioso"; break;
-         default: estado_nome = "Desconhecido"; break;
+     if (todos_validos) {
+         tocar_sucesso();
+     } else {
+         tocar_erro();
      }
+ }
+ 
+ //===============================================
+ // Funções do Display OLED
+ //===============================================
+ 
+ // Atualiza o display no modo de monitoramento. Só redesenha numa
+ // transição (forcar) ou quando os valores exibidos mudam.
+ void atualizar_display_monitoramento(ssd1306_t *ssd, EstadoCognitivo *estado, EstadoMental estado_cognitivo, bool forcar) {
+     static char linha2_anterior[32], linha4_anterior[32];
+     char linha1[32], linha2[32], linha3[32], linha4[32];
+     
+     sprintf(linha2, "Atencao: %.1f%% Rel: %.1f", q16_para_float(estado->atencao), q16_para_float(estado->relaxamento));
+     sprintf(linha4, "TB %.2f Eng %.2f", q16_para_float(estado->theta_beta), q16_para_float(estado->engajamento));
+     if (!forcar && strcmp(linha2, linha2_anterior) == 0 && strcmp(linha4, linha4_anterior) == 0) return;
+     strcpy(linha2_anterior, linha2);
+     strcpy(linha4_anterior, linha4);
      
      sprintf(linha1, "NeuroSync - Monitora");
-     sprintf(linha2, "Atencao: %.1f%% Rel: %.1f", estado->atencao, estado->relaxamento);
-     sprintf(linha3, "Estado: %s", estado_nome);
+     sprintf(linha3, "Estado: %s", classificador_nome(estado_cognitivo));
      
      ssd1306_fill(ssd, 0);
      ssd1306_draw_string(ssd, linha1, 0, 0);
      ssd1306_draw_string(ssd, linha2, 0, 20);
+     ssd1306_draw_string(ssd, linha4, 0, 30);
      ssd1306_draw_string(ssd, linha3, 0, 40);
      ssd1306_send_data(ssd);
  }
@@ -459,19 +1026,45 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
      switch (param_atual) {
          case 0:
              sprintf(linha2, "Limiar Atencao Baixo");
-             sprintf(linha3, "Valor: %.1f%%", limiar_atencao_baixo);
+             sprintf(linha3, "Valor: %.1f%%", q16_para_float(limiar_atencao_baixo));
              break;
          case 1:
              sprintf(linha2, "Limiar Atencao Alto");
-             sprintf(linha3, "Valor: %.1f%%", limiar_atencao_alto);
+             sprintf(linha3, "Valor: %.1f%%", q16_para_float(limiar_atencao_alto));
              break;
          case 2:
              sprintf(linha2, "Limiar Relax Baixo");
-             sprintf(linha3, "Valor: %.1f", limiar_relaxamento_baixo);
+             sprintf(linha3, "Valor: %.1f", q16_para_float(limiar_relaxamento_baixo));
              break;
          case 3:
              sprintf(linha2, "Limiar Relax Alto");
-             sprintf(linha3, "Valor: %.1f", limiar_relaxamento_alto);
+             sprintf(linha3, "Valor: %.1f", q16_para_float(limiar_relaxamento_alto));
+             break;
+         case PARAM_CALIBRACAO: {
+             static const char *nomes_ponto[CALIBRACAO_NUM_PONTOS] = {"MIN", "MEIO", "MAX"};
+             if (!fonte->definir_calibracao) {
+                 sprintf(linha2, "Calibracao");
+                 sprintf(linha3, "Indisponivel: %s", fonte->nome);
+                 break;
+             }
+             int etapa = etapa_calibracao < 0 ? CALIBRACAO_PONTO_MIN : etapa_calibracao;
+             sprintf(linha2, "Calibracao: pots %s", nomes_ponto[etapa]);
+             sprintf(linha3, "X:%5ld Y:%5ld", (long)nivel_bloco[CANAL_ATENCAO],
+                     (long)nivel_bloco[CANAL_RELAXAMENTO]);
+             break;
+         }
+         case PARAM_PERCENTIL_ALVO:
+             sprintf(linha2, "Treino: percentil");
+             sprintf(linha3, "P%u +%u/nivel", config_dificuldade.percentil_base,
+                     config_dificuldade.percentil_por_nivel);
+             break;
+         case PARAM_SUCESSO_MIN:
+             sprintf(linha2, "Treino: sucesso min");
+             sprintf(linha3, "Valor: %u%%", config_dificuldade.sucesso_min);
+             break;
+         case PARAM_SUCESSO_MAX:
+             sprintf(linha2, "Treino: sucesso max");
+             sprintf(linha3, "Valor: %u%%", config_dificuldade.sucesso_max);
              break;
          default:
              sprintf(linha2, "Parametro Desconhecido");
@@ -492,56 +1085,228 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
      
      sprintf(linha1, "NeuroSync - Treino");
      
-     const char *objetivo_nome;
-     switch (treino->objetivo) {
-         case 0: objetivo_nome = "Atencao"; break;
-         case 1: objetivo_nome = "Relaxamento"; break;
-         case 2: objetivo_nome = "Estado Flow"; break;
-         default: objetivo_nome = "Desconhecido"; break;
-     }
+     const Protocolo *protocolo = obter_protocolo(treino->protocolo);
+     const ExecucaoProtocolo *e = &treino->execucao;
      
      uint32_t tempo_decorrido = 0;
      if (treino->status == 1) { // Em andamento
-         tempo_decorrido = time_us_32() / 1000000 - treino->inicio;
+         tempo_decorrido = (uint32_t)(time_us_64() / 1000000) - treino->inicio;
      } else if (treino->status == 2 || treino->status == 3) { // Concluído ou Falha
          tempo_decorrido = treino->duracao;
      }
      
-     sprintf(linha2, "Objetivo: %s Niv:%d/%d", objetivo_nome, treino->nivel_atual, treino->nivel_maximo);
-     sprintf(linha3, "Pontos: %d Tempo: %ds", treino->pontuacao, tempo_decorrido);
+     char linha4[32] = "";
+     if (treino->status == 0) {
+         sprintf(linha2, "Protocolo: %s", protocolo->nome);
+         sprintf(linha4, "%u fase(s) %u/%u", protocolo->num_fases, treino->protocolo + 1, num_protocolos());
+         sprintf(linha3, "SET inicia");
+     } else {
+         sprintf(linha2, "%s F%u/%u Niv:%d/%d", protocolo->nome, e->fase + 1, protocolo->num_fases,
+                 e->nivel, e->nivel_maximo);
+         sprintf(linha3, "Pontos: %lu Tempo: %lus", (unsigned long)e->pontuacao, (unsigned long)tempo_decorrido);
+     }
+     
+     // Primeira condição da fase: alvo adaptativo e taxa de sucesso, ou o
+     // limiar fixo; sem condições é linha de base
+     if (treino->status == 1) {
+         const CondicaoProtocolo *c = &protocolo_fase(e)->condicoes[0];
+         if (c->sinal == SINAL_NENHUM) {
+             sprintf(linha4, "Linha de base %lus", (unsigned long)protocolo_tempo_fase_s(e, instante_niveis_us));
+         } else if (c->regra == REGRA_ALVO) {
+             const Dificuldade *d = c->sinal == SINAL_RELAXAMENTO ? &dificuldade_relaxamento : &dificuldade_atencao;
+             sprintf(linha4, "Alvo: %.1f Suc: %u%%", q16_para_float(d->alvo), dificuldade_taxa_sucesso(d));
+         } else {
+             sprintf(linha4, "Limiar: %s%.2f", c->regra == REGRA_ABAIXO ? "<" : ">", q16_para_float(c->limiar));
+         }
+     }
      
      ssd1306_fill(ssd, 0);
      ssd1306_draw_string(ssd, linha1, 0, 0);
      ssd1306_draw_string(ssd, linha2, 0, 20);
+     ssd1306_draw_string(ssd, linha4, 0, 30);
      ssd1306_draw_string(ssd, linha3, 0, 40);
      ssd1306_send_data(ssd);
  }
  
- // Atualiza o display no modo de histórico
- void atualizar_display_historico(ssd1306_t *ssd, Estatisticas *stats) {
-     char linha1[32], linha2[32], linha3[32];
+ // Página de quantis de um sinal (mediana, P10 e P90 da sessão)
+ static void formatar_quantis(char *linha2, char *linha3, const HistogramaQuantil *h, const char *unidade) {
+     if (h->total == 0) {
+         sprintf(linha2, "Sem amostras");
+         linha3[0] = '\0';
+         return;
+     }
+     sprintf(linha2, "Mediana: %.1f%s", q16_para_float(quantil_consultar(h, 500)), unidade);
+     sprintf(linha3, "P10 %.1f  P90 %.1f", q16_para_float(quantil_consultar(h, 100)),
+             q16_para_float(quantil_consultar(h, 900)));
+ }
+ 
+ // Gráfico da atenção (0-100%) na janela de tendência: a média ligada por
+ // linhas e pontos no mínimo e no máximo de cada coluna
+ void desenhar_grafico_tendencia(ssd1306_t *ssd) {
+     static PontoTendencia pontos[SSD1306_WIDTH];
+     const uint8_t topo = 12, base = SSD1306_HEIGHT - 1;
+     char titulo[32];
      
-     sprintf(linha1, "NeuroSync - Historico");
+     uint32_t validos = tendencia_serie(&tendencia, TENDENCIA_CANAL_ATENCAO, JANELA_GRAFICO_S, pontos, SSD1306_WIDTH);
+     PontoTendencia resumo = tendencia_resumo(&tendencia, TENDENCIA_CANAL_ATENCAO, JANELA_GRAFICO_S);
      
-     float media_atencao = 0.0f;
-     float media_relaxamento = 0.0f;
+     ssd1306_fill(ssd, 0);
+     if (resumo.valido) {
+         sprintf(titulo, "At 30min: %.0f-%.0f%%", q16_para_float(resumo.minimo), q16_para_float(resumo.maximo));
+     } else {
+         sprintf(titulo, "At 30min: sem dados");
+     }
+     ssd1306_draw_string(ssd, titulo, 0, 0);
      
-     if (stats->amostras > 0) {
-         media_atencao = stats->soma_atencao / stats->amostras;
-         media_relaxamento = stats->soma_relaxamento / stats->amostras;
+     int anterior_y = -1;
+     for (int x = 0; x < SSD1306_WIDTH && validos; x++) {
+         if (!pontos[x].valido) {
+             anterior_y = -1;
+             continue;
+         }
+         // Escala 0-100% para base..topo
+         int y = base - q16_para_int(q16_escalar(q16_limitar(pontos[x].media, Q16_ZERO, Q16_INT(100)), base - topo, 100));
+         int y_min = base - q16_para_int(q16_escalar(q16_limitar(pontos[x].minimo, Q16_ZERO, Q16_INT(100)), base - topo, 100));
+         int y_max = base - q16_para_int(q16_escalar(q16_limitar(pontos[x].maximo, Q16_ZERO, Q16_INT(100)), base - topo, 100));
+         if (anterior_y >= 0) {
+             ssd1306_line(ssd, x - 1, anterior_y, x, y, true);
+         } else {
+             ssd1306_pixel(ssd, x, y, true);
+         }
+         ssd1306_pixel(ssd, x, y_min, true);
+         ssd1306_pixel(ssd, x, y_max, true);
+         anterior_y = y;
+     }
+     ssd1306_send_data(ssd);
+ }
+ 
+ // Exporta pela serial todos os baldes de tendência, do mais antigo ao mais
+ // recente em cada nível (comando 'E'); valores em Q8.8 convertidos
+ void exportar_tendencia(void) {
+     printf("TENDENCIA - nivel,duracao_s,idade,at_min,at_med,at_max,rx_min,rx_med,rx_max\n");
+     for (int nivel = 0; nivel < TENDENCIA_NUM_NIVEIS; nivel++) {
+         const NivelTendencia *n = &tendencia.niveis[nivel];
+         for (int idade = n->cheios - 1; idade >= 0; idade--) {
+             BaldeTendencia b;
+             tendencia_balde(&tendencia, nivel, idade, &b);
+             printf("%d,%lu,%d", nivel, (unsigned long)n->duracao_s, idade);
+             for (int c = 0; c < TENDENCIA_NUM_CANAIS; c++) {
+                 const ResumoQ8 *r = &b.canal[c];
+                 if (r->media == TENDENCIA_VAZIO) {
+                     printf(",,,");
+                 } else {
+                     printf(",%.2f,%.2f,%.2f", r->minimo / 256.0f, r->media / 256.0f, r->maximo / 256.0f);
+                 }
+             }
+             printf("\n");
+         }
+     }
+     printf("TENDENCIA - fim\n");
+ }
+ 
+ // Atualiza o display no modo de histórico (página escolhida com SET)
+ void atualizar_display_historico(ssd1306_t *ssd, Estatisticas *stats) {
+     char linha1[32], linha2[32], linha3[32], linha4[32] = "", linha5[32] = "";
+     
+     if (pagina_historico == PAGINA_HISTORICO_TENDENCIA) {
+         desenhar_grafico_tendencia(ssd);
+         return;
      }
      
      uint32_t tempo_total = time_us_32() / 1000000 - stats->tempo_inicio;
      uint32_t minutos = tempo_total / 60;
      uint32_t segundos = tempo_total % 60;
      
-     sprintf(linha2, "At: %.1f%% Rx: %.1f", media_atencao, media_relaxamento);
-     sprintf(linha3, "Sessoes: %d Tempo: %02dm%02ds", stats->sessoes_concluidas, minutos, segundos);
+     switch (pagina_historico) {
+         case PAGINA_HISTORICO_ATENCAO:
+             sprintf(linha1, "Historico - Atencao");
+             formatar_quantis(linha2, linha3, &stats->dist_atencao, "%");
+             break;
+         case PAGINA_HISTORICO_RELAXAMENTO:
+             sprintf(linha1, "Historico - Relax.");
+             formatar_quantis(linha2, linha3, &stats->dist_relaxamento, "");
+             break;
+         case PAGINA_HISTORICO_SESSOES: {
+             static const char *const objetivos[SESSOES_NUM_OBJETIVOS] = {"Atencao", "Relax.", "Flow", "T/B"};
+             static const char *const siglas[NUM_ESTADOS_COGNITIVOS] = {"Dis", "Nor", "Con", "Rel", "Flw", "Ans"};
+             const RegistroSessao *r = sessoes_obter(&sessoes, sessao_exibida);
+             if (!r) {
+                 sprintf(linha1, "Sessoes");
+                 sprintf(linha2, "Nenhuma sessao");
+                 linha3[0] = '\0';
+                 break;
+             }
+             sprintf(linha1, "Sessao %lu/%lu %s %s", (unsigned long)(sessao_exibida + 1),
+                     (unsigned long)sessoes_quantidade(&sessoes),
+                     r->objetivo < SESSOES_NUM_OBJETIVOS ? objetivos[r->objetivo] : "?", r->concluida ? "OK" : "X");
+             sprintf(linha2, "Niv %u Pts %u %us", r->nivel_final, r->pontuacao, r->duracao_s);
+             sprintf(linha3, "No alvo: %lu.%lus", (unsigned long)(r->tempo_no_alvo_ms / 1000),
+                     (unsigned long)(r->tempo_no_alvo_ms % 1000 / 100));
+             
+             // Os dois estados em que a sessão passou mais tempo
+             int primeiro = 0, segundo = 1;
+             if (r->tempo_estado_s[segundo] > r->tempo_estado_s[primeiro]) { primeiro = 1; segundo = 0; }
+             for (int e = 2; e < NUM_ESTADOS_COGNITIVOS; e++) {
+                 if (r->tempo_estado_s[e] > r->tempo_estado_s[primeiro]) {
+                     segundo = primeiro;
+                     primeiro = e;
+                 } else if (r->tempo_estado_s[e] > r->tempo_estado_s[segundo]) {
+                     segundo = e;
+                 }
+             }
+             sprintf(linha4, "%s %us  %s %us", siglas[primeiro], r->tempo_estado_s[primeiro],
+                     siglas[segundo], r->tempo_estado_s[segundo]);
+             break;
+         }
+         case PAGINA_HISTORICO_MELHORES: {
+             static const char *const siglas_objetivo[SESSOES_NUM_OBJETIVOS] = {"At", "Rx", "Fl", "TB"};
+             char *linhas[SESSOES_NUM_OBJETIVOS] = {linha2, linha3, linha4, linha5};
+             sprintf(linha1, "Melhores sessoes");
+             for (int o = 0; o < SESSOES_NUM_OBJETIVOS; o++) {
+                 const ResumoObjetivo *resumo = sessoes_resumo(&sessoes, (uint8_t)o);
+                 if (!resumo->tem_melhor) {
+                     sprintf(linhas[o], "%s: -", siglas_objetivo[o]);
+                 } else {
+                     sprintf(linhas[o], "%s: %up niv%u %lu/%lu", siglas_objetivo[o], resumo->melhor.pontuacao,
+                             resumo->melhor.nivel_final, (unsigned long)resumo->concluidas,
+                             (unsigned long)resumo->sessoes);
+                 }
+             }
+             break;
+         }
+         case PAGINA_HISTORICO_ESTADOS: {
+             // Dois estados por linha, em % do tempo classificado
+             static const char *const siglas[NUM_ESTADOS_COGNITIVOS] = {"Dis", "Nor", "Con", "Rel", "Flw", "Ans"};
+             char *linhas[3] = {linha2, linha3, linha4};
+             uint64_t total = tempo_estado_total_us(&stats->estados);
+             sprintf(linha1, "Estados - %lu trans.", (unsigned long)stats->estados.transicoes);
+             for (int e = 0; e < NUM_ESTADOS_COGNITIVOS; e += 2) {
+                 uint32_t p0 = total ? (uint32_t)(tempo_estado_us(&stats->estados, (EstadoMental)e) * 100 / total) : 0;
+                 uint32_t p1 = total ? (uint32_t)(tempo_estado_us(&stats->estados, (EstadoMental)(e + 1)) * 100 / total) : 0;
+                 sprintf(linhas[e / 2], "%s %3lu%%  %s %3lu%%", siglas[e], (unsigned long)p0,
+                         siglas[e + 1], (unsigned long)p1);
+             }
+             break;
+         }
+         default:
+             sprintf(linha1, "NeuroSync - Historico");
+             sprintf(linha2, "At: %.1f%% Rx: %.1f", q16_para_float(stats->atencao.media), q16_para_float(stats->relaxamento.media));
+             sprintf(linha3, "DP At: %.1f Rx: %.2f", q16_para_float(estatistica_desvio(&stats->atencao)),
+                     q16_para_float(estatistica_desvio(&stats->relaxamento)));
+             break;
+     }
+     // As páginas de estados e de sessões usam a última linha
+     if (pagina_historico != PAGINA_HISTORICO_ESTADOS && pagina_historico != PAGINA_HISTORICO_SESSOES &&
+         pagina_historico != PAGINA_HISTORICO_MELHORES) {
+         sprintf(linha4, "Sessoes: %d Tempo: %02dm%02ds", stats->sessoes_concluidas, minutos, segundos);
+     }
      
      ssd1306_fill(ssd, 0);
      ssd1306_draw_string(ssd, linha1, 0, 0);
      ssd1306_draw_string(ssd, linha2, 0, 20);
-     ssd1306_draw_string(ssd, linha3, 0, 40);
+     ssd1306_draw_string(ssd, linha3, 0, 30);
+     ssd1306_draw_string(ssd, linha4, 0, 40);
+     ssd1306_draw_string(ssd, linha5, 0, 50);
      ssd1306_send_data(ssd);
  }
  
@@ -549,78 +1314,106 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
  // Funções para modos de operação
  //===============================================
  
+ // Tempo acumulado em cada estado (ms) e total de transições
+ void imprimir_tempo_estados(const ContagemEstados *t) {
+     printf("ESTADOS -");
+     for (int e = 0; e < NUM_ESTADOS_COGNITIVOS; e++) {
+         printf(" %s: %lu ms,", classificador_nome((EstadoMental)e),
+                (unsigned long)(tempo_estado_us(t, (EstadoMental)e) / 1000));
+     }
+     printf(" Transicoes: %lu\n", (unsigned long)t->transicoes);
+ }
+ 
+ // Matriz de transições, uma linha por estado de origem
+ void imprimir_matriz_transicoes(const ContagemEstados *t) {
+     printf("MATRIZ -");
+     for (int de = 0; de < NUM_ESTADOS_COGNITIVOS; de++) {
+         printf(" %d:[", de);
+         for (int para = 0; para < NUM_ESTADOS_COGNITIVOS; para++) {
+             printf(para ? " %lu" : "%lu", (unsigned long)t->matriz[de][para]);
+         }
+         printf("]");
+     }
+     printf("\n");
+ }
+ 
  // Modo de monitoramento (principal)
  void executar_modo_monitoramento(ssd1306_t *ssd) {
-     // Lê os valores dos potenciômetros
-     adc_select_input(POT_ATENCAO_PIN - 26);
-     int adc_atencao = adc_read();
-     estado_atual.atencao = obter_nivel_atencao(adc_atencao);
-     
-     adc_select_input(POT_RELAXAMENTO_PIN - 26);
-     int adc_relaxamento = adc_read();
-     estado_atual.relaxamento = obter_nivel_relaxamento(adc_relaxamento);
-     
-     // Simula as ondas cerebrais
-     simular_ondas_cerebrais(&estado_atual);
+     // Atualiza os níveis e as estatísticas com os blocos adquiridos desde o
+     // último ciclo
+     atualizar_niveis_sensores(true);
      
-     // Determina o estado cognitivo atual
-     int estado_cognitivo = determinar_estado_cognitivo(&estado_atual);
+     // Determina o estado cognitivo atual; mudanças só valem como transições
+     EventoTransicao evento;
+     bool transicao = determinar_estado_cognitivo(&estado_atual, &evento);
+     EstadoMental estado_cognitivo = classificador.estado;
+     bool redesenhar = transicao || redesenhar_monitor;
+     redesenhar_monitor = false;
      
      // Envia dados para o terminal serial para depuração
+     tempo_estado_registrar(&stats.estados, estado_cognitivo, instante_niveis_us, transicao ? &evento : NULL);
+     if (transicao) {
+         printf("TRANSICAO - %s -> %s apos %lu ms\n", classificador_nome(evento.de),
+                classificador_nome(evento.para), (unsigned long)(evento.duracao_us / 1000));
+         imprimir_matriz_transicoes(&stats.estados);
+     }
+     imprimir_tempo_estados(&stats.estados);
      printf("MONITOR - Atencao: %.2f, Relaxamento: %.2f, Estado: %d\n", 
-            estado_atual.atencao, estado_atual.relaxamento, estado_cognitivo);
+            q16_para_float(estado_atual.atencao), q16_para_float(estado_atual.relaxamento), (int)estado_cognitivo);
      printf("ONDAS - Alpha: %.2f, Beta: %.2f, Theta: %.2f, Delta: %.2f\n", 
-            estado_atual.alpha, estado_atual.beta, estado_atual.theta, estado_atual.delta);
-     
-     // Atualiza o display
-     atualizar_display_monitoramento(ssd, &estado_atual, estado_cognitivo);
-     
-     // Atualiza a matriz de LEDs conforme o estado
-     switch (estado_cognitivo) {
-         case 0: // Distraído
-             atualizar_buffer_com_carinha(2); // Triste
-             set_rgb_color(255, 255, 0); // Amarelo
-             break;
-         case 1: // Normal
-             atualizar_buffer_com_carinha(0); // Neutra
-             set_rgb_color(0, 0, 255); // Azul
-             break;
-         case 2: // Alta Concentração
-             atualizar_buffer_com_carinha(1); // Feliz
-             set_rgb_color(0, 255, 0); // Verde
-             break;
-         case 3: // Relaxamento Profundo
-             atualizar_buffer_com_carinha(0); // Neutra
-             set_rgb_color(0, 255, 255); // Ciano
-             break;
-         case 4: // Estado Flow
-             atualizar_buffer_com_carinha(1); // Feliz
-             set_rgb_color(0, 255, 128); // Verde-azulado
-             break;
-         case 5: // Ansiedade
-             atualizar_buffer_com_carinha(2); // Triste
-             set_rgb_color(255, 0, 0); // Vermelho
-             break;
+            q16_para_float(estado_atual.alpha), q16_para_float(estado_atual.beta),
+            q16_para_float(estado_atual.theta), q16_para_float(estado_atual.delta));
+     if (metricas_valida(&metricas, metrica_assimetria)) {
+         printf("METRICAS - Theta/Beta: %.2f, Engajamento: %.2f, Assimetria: %.2f, Avaliadas: %lu, Tempo: %lu us\n",
+                q16_para_float(estado_atual.theta_beta), q16_para_float(estado_atual.engajamento),
+                q16_para_float(estado_atual.assimetria),
+                (unsigned long)metricas.avaliacoes, (unsigned long)tempo_metricas_us);
+     } else {
+         printf("METRICAS - Theta/Beta: %.2f, Engajamento: %.2f, Assimetria: --, Avaliadas: %lu, Tempo: %lu us\n",
+                q16_para_float(estado_atual.theta_beta), q16_para_float(estado_atual.engajamento),
+                (unsigned long)metricas.avaliacoes, (unsigned long)tempo_metricas_us);
      }
+     printf("CLASSIFICADOR - %s (confianca %u), inferencia: %lu us (max %lu us), ciclos modelo/regras: %lu/%lu\n",
+            modelo_disponivel() && CLASSIFICADOR_MODELO ? "Modelo" : "Regras", confianca_modelo,
+            (unsigned long)tempo_modelo_us, (unsigned long)tempo_modelo_max_us,
+            (unsigned long)ciclos_modelo, (unsigned long)ciclos_regras);
+     printf("FFT - Bloco: %lu us, Pior caso: %lu us, Filtros: %lu us, Gerador: %lu us\n",
+            (unsigned long)tempo_fft_us, (unsigned long)tempo_fft_max_us,
+            (unsigned long)tempo_filtros_us, (unsigned long)tempo_gerador_us);
+     uint32_t taxa_eeg = artefato_taxa_milesimos(&artefato_eeg);
+     uint32_t taxa_at = artefato_taxa_milesimos(&artefato_nivel[CANAL_ATENCAO]);
+     uint32_t taxa_rx = artefato_taxa_milesimos(&artefato_nivel[CANAL_RELAXAMENTO]);
+     printf("ARTEFATOS - EEG: %lu.%lu%% (sat %lu, salto %lu, plano %lu), At: %lu.%lu%%, Rx: %lu.%lu%%, Janelas descartadas: %lu\n",
+            (unsigned long)(taxa_eeg / 10), (unsigned long)(taxa_eeg % 10),
+            (unsigned long)artefato_eeg.por_tipo[ARTEFATO_SATURACAO],
+            (unsigned long)artefato_eeg.por_tipo[ARTEFATO_SALTO],
+            (unsigned long)artefato_eeg.por_tipo[ARTEFATO_PLANO],
+            (unsigned long)(taxa_at / 10), (unsigned long)(taxa_at % 10),
+            (unsigned long)(taxa_rx / 10), (unsigned long)(taxa_rx % 10),
+            (unsigned long)janelas_descartadas);
+     printf("FONTE - %s: %lu quadros no anel, %lu descartados (anel cheio)\n",
+            fonte->nome, (unsigned long)anel_ocupacao(fonte->anel), (unsigned long)fonte->anel->estouros);
      
-     definir_leds(COR_WS2812_R, COR_WS2812_G, COR_WS2812_B);
-     
-     // Atualiza estatísticas
-     stats.soma_atencao += estado_atual.atencao;
-     stats.soma_relaxamento += estado_atual.relaxamento;
-     stats.amostras++;
-     
-     if (estado_atual.atencao > stats.max_atencao) {
-         stats.max_atencao = estado_atual.atencao;
-     }
+     // Atualiza o display
+     atualizar_display_monitoramento(ssd, &estado_atual, estado_cognitivo, redesenhar);
      
-     if (estado_atual.relaxamento > stats.max_relaxamento) {
-         stats.max_relaxamento = estado_atual.relaxamento;
+     // Matriz de LEDs e LED RGB só mudam nas transições
+     if (redesenhar) {
+         const AparenciaEstado *aparencia = &aparencia_estado[estado_cognitivo];
+         atualizar_buffer_com_carinha(aparencia->carinha);
+         set_rgb_color(aparencia->r, aparencia->g, aparencia->b);
+         definir_leds(COR_WS2812_R, COR_WS2812_G, COR_WS2812_B);
      }
  }
  
  // Modo de configuração
  void executar_modo_configuracao(ssd1306_t *ssd) {
+     // A calibração acompanha as leituras brutas ao vivo
+     if (current_param == PARAM_CALIBRACAO) {
+         if (etapa_calibracao < 0) iniciar_calibracao();
+         atualizar_niveis_sensores(false);
+     }
+     
      // Atualiza o display com o parâmetro atual
      atualizar_display_configuracao(ssd, current_param);
      
@@ -633,33 +1426,42 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
              // Aumenta o valor do parâmetro atual
              switch (current_param) {
                  case 0: // Limiar Atenção Baixo
-                     limiar_atencao_baixo += 5.0f;
-                     if (limiar_atencao_baixo > limiar_atencao_alto - 5.0f) {
-                         limiar_atencao_baixo = limiar_atencao_alto - 5.0f;
-                     }
-                     if (limiar_atencao_baixo > 95.0f) {
-                         limiar_atencao_baixo = 95.0f;
-                     }
+                     limiar_atencao_baixo = q16_somar(limiar_atencao_baixo, PASSO_LIMIAR_ATENCAO);
+                     limiar_atencao_baixo = q16_min(limiar_atencao_baixo,
+                                                    q16_subtrair(limiar_atencao_alto, PASSO_LIMIAR_ATENCAO));
+                     limiar_atencao_baixo = q16_min(limiar_atencao_baixo, Q16_INT(95));
                      break;
                  case 1: // Limiar Atenção Alto
-                     limiar_atencao_alto += 5.0f;
-                     if (limiar_atencao_alto > 100.0f) {
-                         limiar_atencao_alto = 100.0f;
-                     }
+                     limiar_atencao_alto = q16_somar(limiar_atencao_alto, PASSO_LIMIAR_ATENCAO);
+                     limiar_atencao_alto = q16_min(limiar_atencao_alto, Q16_INT(100));
                      break;
                  case 2: // Limiar Relaxamento Baixo
-                     limiar_relaxamento_baixo += 0.5f;
-                     if (limiar_relaxamento_baixo > limiar_relaxamento_alto - 0.5f) {
-                         limiar_relaxamento_baixo = limiar_relaxamento_alto - 0.5f;
+                     limiar_relaxamento_baixo = q16_somar(limiar_relaxamento_baixo, PASSO_LIMIAR_RELAXAMENTO);
+                     limiar_relaxamento_baixo = q16_min(limiar_relaxamento_baixo,
+                                                        q16_subtrair(limiar_relaxamento_alto, PASSO_LIMIAR_RELAXAMENTO));
+                     limiar_relaxamento_baixo = q16_min(limiar_relaxamento_baixo, Q16_CONST(9.5));
+                     break;
+                 case 3: // Limiar Relaxamento Alto
+                     limiar_relaxamento_alto = q16_somar(limiar_relaxamento_alto, PASSO_LIMIAR_RELAXAMENTO);
+                     limiar_relaxamento_alto = q16_min(limiar_relaxamento_alto, Q16_INT(10));
+                     break;
+                 case PARAM_CALIBRACAO: // Captura o ponto atual
+                     capturar_ponto_calibracao();
+                     break;
+                 case PARAM_PERCENTIL_ALVO: // Percentil do nível 1 (o do nível 10 não passa de 100)
+                     if (config_dificuldade.percentil_base + PASSO_PERCENTUAL_DIFICULDADE +
+                         9 * config_dificuldade.percentil_por_nivel <= 100) {
+                         config_dificuldade.percentil_base += PASSO_PERCENTUAL_DIFICULDADE;
                      }
-                     if (limiar_relaxamento_baixo > 9.5f) {
-                         limiar_relaxamento_baixo = 9.5f;
+                     break;
+                 case PARAM_SUCESSO_MIN: // Faixa de sucesso com pelo menos 10 pontos
+                     if (config_dificuldade.sucesso_min + PASSO_PERCENTUAL_DIFICULDADE + 10 <= config_dificuldade.sucesso_max) {
+                         config_dificuldade.sucesso_min += PASSO_PERCENTUAL_DIFICULDADE;
                      }
                      break;
-                 case 3: // Limiar Relaxamento Alto
-                     limiar_relaxamento_alto += 0.5f;
-                     if (limiar_relaxamento_alto > 10.0f) {
-                         limiar_relaxamento_alto = 10.0f;
+                 case PARAM_SUCESSO_MAX:
+                     if (config_dificuldade.sucesso_max + PASSO_PERCENTUAL_DIFICULDADE <= 100) {
+                         config_dificuldade.sucesso_max += PASSO_PERCENTUAL_DIFICULDADE;
                      }
                      break;
              }
@@ -675,27 +1477,39 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
              // Diminui o valor do parâmetro atual
              switch (current_param) {
                  case 0: // Limiar Atenção Baixo
-                     limiar_atencao_baixo -= 5.0f;
-                     if (limiar_atencao_baixo < 5.0f) {
-                         limiar_atencao_baixo = 5.0f;
-                     }
+                     limiar_atencao_baixo = q16_subtrair(limiar_atencao_baixo, PASSO_LIMIAR_ATENCAO);
+                     limiar_atencao_baixo = q16_max(limiar_atencao_baixo, PASSO_LIMIAR_ATENCAO);
                      break;
                  case 1: // Limiar Atenção Alto
-                     limiar_atencao_alto -= 5.0f;
-                     if (limiar_atencao_alto < limiar_atencao_baixo + 5.0f) {
-                         limiar_atencao_alto = limiar_atencao_baixo + 5.0f;
-                     }
+                     limiar_atencao_alto = q16_subtrair(limiar_atencao_alto, PASSO_LIMIAR_ATENCAO);
+                     limiar_atencao_alto = q16_max(limiar_atencao_alto,
+                                                   q16_somar(limiar_atencao_baixo, PASSO_LIMIAR_ATENCAO));
                      break;
                  case 2: // Limiar Relaxamento Baixo
-                     limiar_relaxamento_baixo -= 0.5f;
-                     if (limiar_relaxamento_baixo < 0.5f) {
-                         limiar_relaxamento_baixo = 0.5f;
-                     }
+                     limiar_relaxamento_baixo = q16_subtrair(limiar_relaxamento_baixo, PASSO_LIMIAR_RELAXAMENTO);
+                     limiar_relaxamento_baixo = q16_max(limiar_relaxamento_baixo, PASSO_LIMIAR_RELAXAMENTO);
                      break;
                  case 3: // Limiar Relaxamento Alto
-                     limiar_relaxamento_alto -= 0.5f;
-                     if (limiar_relaxamento_alto < limiar_relaxamento_baixo + 0.5f) {
-                         limiar_relaxamento_alto = limiar_relaxamento_baixo + 0.5f;
+                     limiar_relaxamento_alto = q16_subtrair(limiar_relaxamento_alto, PASSO_LIMIAR_RELAXAMENTO);
+                     limiar_relaxamento_alto = q16_max(limiar_relaxamento_alto,
+                                                       q16_somar(limiar_relaxamento_baixo, PASSO_LIMIAR_RELAXAMENTO));
+                     break;
+                 case PARAM_CALIBRACAO: // Recomeça a captura pelo mínimo
+                     iniciar_calibracao();
+                     break;
+                 case PARAM_PERCENTIL_ALVO:
+                     if (config_dificuldade.percentil_base >= 10 + PASSO_PERCENTUAL_DIFICULDADE) {
+                         config_dificuldade.percentil_base -= PASSO_PERCENTUAL_DIFICULDADE;
+                     }
+                     break;
+                 case PARAM_SUCESSO_MIN:
+                     if (config_dificuldade.sucesso_min >= PASSO_PERCENTUAL_DIFICULDADE) {
+                         config_dificuldade.sucesso_min -= PASSO_PERCENTUAL_DIFICULDADE;
+                     }
+                     break;
+                 case PARAM_SUCESSO_MAX:
+                     if (config_dificuldade.sucesso_max >= config_dificuldade.sucesso_min + 10 + PASSO_PERCENTUAL_DIFICULDADE) {
+                         config_dificuldade.sucesso_max -= PASSO_PERCENTUAL_DIFICULDADE;
                      }
                      break;
              }
@@ -710,24 +1524,36 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
      }
      
      // Acende LEDs conforme o valor atual
-     float valor_percentual = 0.0f;
+     q16_t valor_percentual = Q16_ZERO;   // Fração do fundo de escala, Q16.16
      switch (current_param) {
          case 0: // Limiar Atenção Baixo
-             valor_percentual = limiar_atencao_baixo / 100.0f;
+             valor_percentual = q16_escalar(limiar_atencao_baixo, 1, 100);
              break;
          case 1: // Limiar Atenção Alto
-             valor_percentual = limiar_atencao_alto / 100.0f;
+             valor_percentual = q16_escalar(limiar_atencao_alto, 1, 100);
              break;
          case 2: // Limiar Relaxamento Baixo
-             valor_percentual = limiar_relaxamento_baixo / 10.0f;
+             valor_percentual = q16_escalar(limiar_relaxamento_baixo, 1, 10);
              break;
          case 3: // Limiar Relaxamento Alto
-             valor_percentual = limiar_relaxamento_alto / 10.0f;
+             valor_percentual = q16_escalar(limiar_relaxamento_alto, 1, 10);
+             break;
+         case PARAM_CALIBRACAO: // Pontos já capturados
+             valor_percentual = q16_fracao(etapa_calibracao < 0 ? 0 : etapa_calibracao, CALIBRACAO_NUM_PONTOS);
+             break;
+         case PARAM_PERCENTIL_ALVO:
+             valor_percentual = q16_fracao(config_dificuldade.percentil_base, 100);
+             break;
+         case PARAM_SUCESSO_MIN:
+             valor_percentual = q16_fracao(config_dificuldade.sucesso_min, 100);
+             break;
+         case PARAM_SUCESSO_MAX:
+             valor_percentual = q16_fracao(config_dificuldade.sucesso_max, 100);
              break;
      }
      
      // Acende LEDs proporcionalmente ao valor
-     int leds_acesos = (int)(valor_percentual * NUM_PIXELS);
+     int leds_acesos = q16_para_int(q16_escalar(valor_percentual, NUM_PIXELS, 1));
      for (int i = 0; i < leds_acesos; i++) {
          buffer_leds[i] = true;
      }
@@ -740,24 +1566,46 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
          case 2: case 3: // Parâmetros de Relaxamento
              set_rgb_color(0, 255, 255); // Ciano
              break;
+         case PARAM_CALIBRACAO:
+             set_rgb_color(255, 128, 0); // Laranja
+             break;
+         case PARAM_PERCENTIL_ALVO: case PARAM_SUCESSO_MIN: case PARAM_SUCESSO_MAX: // Treino
+             set_rgb_color(128, 0, 255); // Violeta
+             break;
      }
      
      definir_leds(COR_WS2812_R, COR_WS2812_G, COR_WS2812_B);
  }
  
+ // Campos de 16 bits do registro ficam no máximo em vez de dar a volta
+ static inline uint16_t saturar_u16(uint64_t v) {
+     return v > UINT16_MAX ? UINT16_MAX : (uint16_t)v;
+ }
+ 
+ // Guarda o resumo da sessão encerrada (concluída ou por tempo esgotado)
+ void registrar_sessao(const DadosTreinamento *t) {
+     RegistroSessao r = {
+         .inicio_s = t->inicio,
+         .tempo_no_alvo_ms = (uint32_t)(t->execucao.tempo_no_alvo_us / 1000),
+         .duracao_s = saturar_u16(t->duracao),
+         .pontuacao = (uint16_t)t->execucao.pontuacao,
+         .objetivo = t->execucao.protocolo->objetivo,
+         .nivel_final = t->execucao.nivel,
+         .concluida = t->status == 2,
+     };
+     for (int e = 0; e < NUM_ESTADOS_COGNITIVOS; e++) {
+         r.tempo_estado_s[e] = saturar_u16(tempo_estado_us(&estados_sessao, (EstadoMental)e) / 1000000);
+     }
+     sessoes_adicionar(&sessoes, &r);
+     
+     stats.sessoes_concluidas++;
+     stats.tempo_ultimo_treino = t->duracao;
+ }
+ 
  // Modo de treinamento
  void executar_modo_treinamento(ssd1306_t *ssd) {
-     // Lê os valores dos potenciômetros
-     adc_select_input(POT_ATENCAO_PIN - 26);
-     int adc_atencao = adc_read();
-     estado_atual.atencao = obter_nivel_atencao(adc_atencao);
-     
-     adc_select_input(POT_RELAXAMENTO_PIN - 26);
-     int adc_relaxamento = adc_read();
-     estado_atual.relaxamento = obter_nivel_relaxamento(adc_relaxamento);
-     
-     // Simula as ondas cerebrais
-     simular_ondas_cerebrais(&estado_atual);
+     // Atualiza os níveis com os blocos adquiridos desde o último ciclo
+     atualizar_niveis_sensores(false);
      
      // Se o treinamento não foi iniciado, configura
      if (treinamento.status == 0) {
@@ -767,8 +1615,8 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
              if (current_time - last_button_time > DEBOUNCE_DELAY_MS) {
                  last_button_time = current_time;
                  
-                 // Alterna entre os tipos de treinamento
-                 treinamento.objetivo = (treinamento.objetivo + 1) % 3;
+                 // Alterna entre os protocolos
+                 treinamento.protocolo = (uint8_t)((treinamento.protocolo + 1) % num_protocolos());
                  beep();
              }
          }
@@ -781,10 +1629,14 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
                  
                  // Inicia o treinamento
                  treinamento.status = 1; // Em andamento
-                 treinamento.inicio = time_us_32() / 1000000;
-                 treinamento.nivel_atual = 1;
-                 treinamento.nivel_maximo = 10;
-                 treinamento.pontuacao = 0;
+                 treinamento.inicio = (uint32_t)(time_us_64() / 1000000);
+                 protocolo_iniciar(&treinamento.execucao, obter_protocolo(treinamento.protocolo), instante_niveis_us);
+                 treinamento.instante_pontuado_us = instante_niveis_us;
+                 dificuldade_iniciar(&dificuldade_atencao, &config_dificuldade, limiar_atencao_alto,
+                                     Q16_INT(1), limiar_atencao_baixo, Q16_INT(100), instante_niveis_us);
+                 dificuldade_iniciar(&dificuldade_relaxamento, &config_dificuldade, limiar_relaxamento_alto,
+                                     Q16_CONST(0.1), limiar_relaxamento_baixo, Q16_INT(10), instante_niveis_us);
+                 tempo_estado_zerar(&estados_sessao);
                  
                  tocar_sucesso();
              }
@@ -792,57 +1644,68 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
      }
      // Se o treinamento está em andamento
      else if (treinamento.status == 1) {
-         // Verifica se atingiu o objetivo conforme o tipo de treinamento
-         bool objetivo_atingido = false;
+         // O tempo de aquisição desde a última avaliação conta como no alvo
+         // se os níveis mais recentes atingem o objetivo
+         uint64_t intervalo_us = instante_niveis_us - treinamento.instante_pontuado_us;
+         if (instante_niveis_us < treinamento.instante_pontuado_us) intervalo_us = 0;
+         if (intervalo_us > INTERVALO_CREDITO_MAX_US) intervalo_us = INTERVALO_CREDITO_MAX_US;
+         treinamento.instante_pontuado_us = instante_niveis_us;
          
-         switch (treinamento.objetivo) {
-             case 0: // Atenção
-                 objetivo_atingido = estado_atual.atencao >= limiar_atencao_alto;
-                 break;
-             case 1: // Relaxamento
-                 objetivo_atingido = estado_atual.relaxamento >= limiar_relaxamento_alto;
-                 break;
-             case 2: // Estado Flow
-                 objetivo_atingido = (estado_atual.atencao >= limiar_atencao_alto && 
-                                      estado_atual.relaxamento >= limiar_relaxamento_alto);
-                 break;
+         // O protocolo avalia as condições da fase contra os sinais atuais e os
+         // alvos adaptativos do nível atual; métricas ainda sem valor não
+         // contam como no alvo
+         const q16_t sinais[NUM_SINAIS_PROTOCOLO] = {
+             [SINAL_ATENCAO] = estado_atual.atencao,
+             [SINAL_RELAXAMENTO] = estado_atual.relaxamento,
+             [SINAL_THETA_BETA] = estado_atual.theta_beta,
+             [SINAL_ENGAJAMENTO] = estado_atual.engajamento,
+             [SINAL_ASSIMETRIA] = estado_atual.assimetria,
+         };
+         const q16_t alvos[NUM_SINAIS_PROTOCOLO] = {
+             [SINAL_ATENCAO] = dificuldade_atencao.alvo,
+             [SINAL_RELAXAMENTO] = dificuldade_relaxamento.alvo,
+         };
+         ExecucaoProtocolo *execucao = &treinamento.execucao;
+         const FaseProtocolo *fase = protocolo_fase(execucao);
+         uint32_t inicio_passo = time_us_32();
+         uint8_t eventos = protocolo_passo(execucao, sinais, alvos, sinais_validos(), intervalo_us, instante_niveis_us);
+         tempo_protocolo_us = time_us_32() - inicio_passo;
+         if (tempo_protocolo_us > tempo_protocolo_max_us) tempo_protocolo_max_us = tempo_protocolo_us;
+         
+         // O estado cognitivo também é acompanhado durante a sessão
+         EventoTransicao evento;
+         bool transicao = determinar_estado_cognitivo(&estado_atual, &evento);
+         tempo_estado_registrar(&estados_sessao, classificador.estado, instante_niveis_us, transicao ? &evento : NULL);
+         
+         // Só os sinais com alvo adaptativo na fase adaptam o alvo
+         for (int c = 0; c < PROTOCOLO_MAX_CONDICOES && intervalo_us > 0; c++) {
+             const CondicaoProtocolo *cond = &fase->condicoes[c];
+             if (cond->sinal == SINAL_NENHUM) break;
+             if (cond->regra != REGRA_ALVO) continue;
+             Dificuldade *d = cond->sinal == SINAL_RELAXAMENTO ? &dificuldade_relaxamento : &dificuldade_atencao;
+             dificuldade_registrar(d, sinais[cond->sinal], intervalo_us, (execucao->condicoes_no_alvo >> c) & 1,
+                                   instante_niveis_us, execucao->nivel);
          }
          
-         // Se atingiu o objetivo, aumenta a pontuação
-         if (objetivo_atingido) {
-             treinamento.pontuacao += 1;
-             
-             // A cada 50 pontos, aumenta o nível se não estiver no máximo
-             if (treinamento.pontuacao % 50 == 0 && treinamento.nivel_atual < treinamento.nivel_maximo) {
-                 treinamento.nivel_atual++;
-                 tocar_sucesso();
-                 
-                 // Se chegou ao nível máximo, conclui com sucesso
-                 if (treinamento.nivel_atual == treinamento.nivel_maximo) {
-                     treinamento.status = 2; // Concluído
-                     treinamento.duracao = time_us_32() / 1000000 - treinamento.inicio;
-                     stats.sessoes_concluidas++;
-                     stats.tempo_ultimo_treino = treinamento.duracao;
-                 }
-             }
+         // Recompensas da fase em que o passo aconteceu
+         if ((eventos & EVENTO_PROTOCOLO_NIVEL) && (fase->recompensas & RECOMPENSA_SOM_NIVEL)) {
+             tocar_sucesso();
+         } else if ((eventos & EVENTO_PROTOCOLO_FASE) && (fase->recompensas & RECOMPENSA_SOM_FASE)) {
+             tocar_sucesso();
          }
          
-         // Verifica o tempo limite (5 minutos)
-         uint32_t tempo_decorrido = time_us_32() / 1000000 - treinamento.inicio;
-         if (tempo_decorrido >= 300) { // 5 minutos
-             // Se não atingiu o nível máximo, considera como falha
-             if (treinamento.nivel_atual < treinamento.nivel_maximo) {
-                 treinamento.status = 3; // Falha
-             } else {
-                 treinamento.status = 2; // Concluído
-             }
-             treinamento.duracao = tempo_decorrido;
-             stats.sessoes_concluidas++;
-             stats.tempo_ultimo_treino = treinamento.duracao;
-             
-             tocar_erro();
+         if (eventos & (EVENTO_PROTOCOLO_CONCLUIDO | EVENTO_PROTOCOLO_FALHA)) {
+             treinamento.status = (eventos & EVENTO_PROTOCOLO_CONCLUIDO) ? 2 : 3;
+             treinamento.duracao = (uint32_t)(time_us_64() / 1000000) - treinamento.inicio;
+             registrar_sessao(&treinamento);
+             if (treinamento.status == 3) tocar_erro();
          }
          
+         printf("PROTOCOLO - %s: fase %u/%u, nivel %u/%u, no alvo %d, eventos 0x%02x, passo %lu us (max %lu us)\n",
+                execucao->protocolo->nome, execucao->fase + 1, execucao->protocolo->num_fases,
+                execucao->nivel, execucao->nivel_maximo, (int)execucao->no_alvo, eventos,
+                (unsigned long)tempo_protocolo_us, (unsigned long)tempo_protocolo_max_us);
+         
          // Botão SET cancelará o treinamento
          if (gpio_get(BUTTON_SET) == 0) { // Botão pressionado
              uint32_t current_time = time_us_32() / 1000;
@@ -870,6 +1733,14 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
          }
      }
      
+     // Sonificação contínua acompanha apenas as fases em andamento que a pedem
+     if (treinamento.status == 1 &&
+         (protocolo_fase(&treinamento.execucao)->recompensas & RECOMPENSA_SONIFICACAO)) {
+         audio_feedback_atualizar(estado_atual.atencao, estado_atual.relaxamento);
+     } else {
+         audio_feedback_parar();
+     }
+     
      // Atualiza o display
      atualizar_display_treinamento(ssd, &treinamento);
      
@@ -879,8 +1750,9 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
      }
      
      // Estados visuais conforme o objetivo e progresso
+     uint8_t objetivo = obter_protocolo(treinamento.protocolo)->objetivo;
      if (treinamento.status == 0) { // Não iniciado
-         switch (treinamento.objetivo) {
+         switch (objetivo) {
              case 0: // Atenção
                  for (int linha = 0; linha < 5; linha++) {
                      for (int coluna = 0; coluna < 5; coluna++) {
@@ -903,12 +1775,16 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
                  atualizar_buffer_com_ondas();
                  set_rgb_color(0, 255, 0); // Verde
                  break;
+             case 3: // Theta/Beta
+                 atualizar_buffer_com_ondas();
+                 set_rgb_color(255, 0, 255); // Magenta
+                 break;
          }
      }
      else if (treinamento.status == 1) { // Em andamento
          // Exibe o nível atual visualmente
-         int leds_por_nivel = NUM_PIXELS / treinamento.nivel_maximo;
-         int leds_acesos = leds_por_nivel * treinamento.nivel_atual;
+         int leds_por_nivel = NUM_PIXELS / treinamento.execucao.nivel_maximo;
+         int leds_acesos = leds_por_nivel * treinamento.execucao.nivel;
          if (leds_acesos > NUM_PIXELS) leds_acesos = NUM_PIXELS;
          
          for (int i = 0; i < leds_acesos; i++) {
@@ -916,7 +1792,7 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
          }
          
          // Cor conforme o objetivo
-         switch (treinamento.objetivo) {
+         switch (objetivo) {
              case 0: // Atenção
                  set_rgb_color(0, 0, 255); // Azul
                  break;
@@ -926,6 +1802,9 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
              case 2: // Estado Flow
                  set_rgb_color(0, 255, 0); // Verde
                  break;
+             case 3: // Theta/Beta
+                 set_rgb_color(255, 0, 255); // Magenta
+                 break;
          }
      }
      else if (treinamento.status == 2) { // Concluído com sucesso
@@ -954,11 +1833,13 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
              // Confirma com NEXT para evitar limpeza acidental
              if (gpio_get(BUTTON_NEXT) == 0) {
                  // Limpa as estatísticas
-                 stats.soma_atencao = 0.0f;
-                 stats.soma_relaxamento = 0.0f;
-                 stats.max_atencao = 0.0f;
-                 stats.max_relaxamento = 0.0f;
-                 stats.amostras = 0;
+                 estatistica_zerar(&stats.atencao);
+                 estatistica_zerar(&stats.relaxamento);
+                 quantil_zerar(&stats.dist_atencao);
+                 quantil_zerar(&stats.dist_relaxamento);
+                 tempo_estado_zerar(&stats.estados);
+                 tendencia_init(&tendencia);
+                 sessoes_init(&sessoes);
                  stats.tempo_inicio = time_us_32() / 1000000;
                  stats.sessoes_concluidas = 0;
                  
@@ -968,13 +1849,8 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
      }
      
      // Mostra as estatísticas visualmente
-     float media_atencao = 0.0f;
-     float media_relaxamento = 0.0f;
-     
-     if (stats.amostras > 0) {
-         media_atencao = stats.soma_atencao / stats.amostras;
-         media_relaxamento = stats.soma_relaxamento / stats.amostras;
-     }
+     q16_t media_atencao = stats.atencao.media;
+     q16_t media_relaxamento = stats.relaxamento.media;
      
      // Matriz limpa
      for (int i = 0; i < NUM_PIXELS; i++) {
@@ -982,13 +1858,13 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
      }
      
      // Primeira linha (0-4): Representa média de atenção
-     int leds_atencao = (int)(media_atencao / 100.0f * 5.0f);
+     int leds_atencao = q16_para_int(q16_escalar(media_atencao, 1, 20));     // / 100 * 5
      for (int i = 0; i < leds_atencao && i < 5; i++) {
          buffer_leds[i] = true;
      }
      
      // Segunda linha (5-9): Representa média de relaxamento
-     int leds_relaxamento = (int)(media_relaxamento / 10.0f * 5.0f);
+     int leds_relaxamento = q16_para_int(q16_escalar(media_relaxamento, 1, 2));   // / 10 * 5
      for (int i = 0; i < leds_relaxamento && i < 5; i++) {
          buffer_leds[i + 5] = true;
      }
@@ -1016,8 +1892,17 @@ void button_callback(uint gpio, uint32_t events) {
     
     if (gpio == BUTTON_SET && (events & GPIO_IRQ_EDGE_FALL)) {
         // Em modo de treinamento, o botão SET já tem comportamento específico
-        // então não alteramos o modo global
-        if (menu_index != 2) {
+        // então não alteramos o modo global; no histórico ele troca a página
+        if (menu_index == 3 && !in_set_mode) {
+            // Na página de sessões, SET percorre as sessões antes de avançar
+            if (pagina_historico == PAGINA_HISTORICO_SESSOES && sessao_exibida + 1 < sessoes_quantidade(&sessoes)) {
+                sessao_exibida++;
+            } else {
+                pagina_historico = (pagina_historico + 1) % NUM_PAGINAS_HISTORICO;
+                sessao_exibida = 0;
+            }
+            beep();
+        } else if (menu_index != 2) {
             if (!in_set_mode) {
                 // Entra no modo de configuração do parâmetro atual
                 in_set_mode = true;
@@ -1025,7 +1910,7 @@ void button_callback(uint gpio, uint32_t events) {
             } else {
                 // Avança para o próximo parâmetro ou sai do modo de configuração
                 current_param++;
-                if (current_param > 3) {
+                if (current_param >= NUM_PARAMETROS_CONFIG) {
                     in_set_mode = false;
                     current_param = 0;  // Corrige o bug do "Parâmetro Desconhecido"
                 }
@@ -1037,7 +1922,7 @@ void button_callback(uint gpio, uint32_t events) {
         // não mudamos de modo (deixa a função executar_modo_treinamento() tratar isso)
         if (menu_index == 2 && treinamento.status == 0) {
             // Apenas emite um beep, mas não muda o menu_index
-            treinamento.objetivo = (treinamento.objetivo + 1) % 3;
+            treinamento.protocolo = (uint8_t)((treinamento.protocolo + 1) % num_protocolos());
             beep();
         }
         // Caso contrário, se não estiver em modo de configuração, avança para o próximo menu
@@ -1080,18 +1965,94 @@ void button_callback(uint gpio, uint32_t events) {
          sleep_ms(50);
      }
      
-     // Sequência sonora de inicialização
-     play_tone(BUZZER1_PIN, 523, 200); // Do
-     sleep_ms(50);
-     play_tone(BUZZER1_PIN, 659, 200); // Mi
-     sleep_ms(50);
-     play_tone(BUZZER1_PIN, 784, 200); // Sol
-     sleep_ms(50);
-     play_tone(BUZZER1_PIN, 1047, 400); // Do (oitava acima)
+     // Sequência sonora de inicialização (Do-Mi-Sol-Do)
+     audio_solicitar(AUDIO_SOM_INICIALIZACAO);
+     sleep_ms(audio_duracao_ms(AUDIO_SOM_INICIALIZACAO));
      
      sleep_ms(1000);
  }
  
+ //===============================================
+ // Comandos pela serial
+ //===============================================
+ 
+ // Guarda um protocolo recebido; um nome já carregado é substituído, e com
+ // todos os espaços ocupados sai o mais antigo. Não mexe no protocolo de uma
+ // sessão em andamento.
+ void carregar_protocolo(const char *linha) {
+     if (treinamento.status == 1) {
+         printf("PROTOCOLO - Recusado: treino em andamento\n");
+         return;
+     }
+     Protocolo novo;
+     if (!protocolo_interpretar_texto(linha, &novo)) {
+         printf("PROTOCOLO - Invalido: %s\n", linha);
+         return;
+     }
+     if (protocolo_sinais_usados(&novo) & ~sinais_disponiveis()) {
+         printf("PROTOCOLO - Recusado: usa sinal indisponivel nesta build (assimetria exige a derivacao par)\n");
+         return;
+     }
+     
+     uint32_t espaco = proximo_protocolo_carregado;
+     for (uint32_t i = 0; i < num_protocolos_carregados; i++) {
+         if (strcmp(protocolos_carregados[i].nome, novo.nome) == 0) espaco = i;
+     }
+     if (espaco == proximo_protocolo_carregado) {
+         proximo_protocolo_carregado = (proximo_protocolo_carregado + 1) % MAX_PROTOCOLOS_CARREGADOS;
+         if (num_protocolos_carregados < MAX_PROTOCOLOS_CARREGADOS) num_protocolos_carregados++;
+     }
+     protocolos_carregados[espaco] = novo;
+     printf("PROTOCOLO - Carregado: %s (%u fases) no indice %lu\n", novo.nome, novo.num_fases,
+            (unsigned long)(NUM_PROTOCOLOS_EMBUTIDOS + espaco));
+ }
+ 
+ // Lê os comandos disponíveis sem bloquear: 'E' exporta o histórico de
+ // tendência, 'L' lista os protocolos, "P <protocolo>" (até o fim da linha,
+ // no formato de protocolo.c) carrega um protocolo, 'V' liga ou desliga a
+ // gravação dos vetores de características e '0'-'5' / '-' definem o rótulo
+ // gravado
+ void processar_comandos_serial(void) {
+     static char linha[160];
+     static uint32_t tamanho = 0;
+     static bool lendo_protocolo = false;
+     
+     int c;
+     while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+         if (lendo_protocolo) {
+             if (c == '\r' || c == '\n') {
+                 linha[tamanho] = '\0';
+                 lendo_protocolo = false;
+                 carregar_protocolo(linha);
+             } else if (tamanho + 1 < sizeof(linha)) {
+                 linha[tamanho++] = (char)c;
+             }
+             continue;
+         }
+         if (c == 'E' || c == 'e') {
+             exportar_tendencia();
+         } else if (c == 'L' || c == 'l') {
+             for (uint32_t i = 0; i < num_protocolos(); i++) {
+                 const Protocolo *p = obter_protocolo(i);
+                 printf("PROTOCOLO - %lu: %s, %u fases, objetivo %u%s\n", (unsigned long)i, p->nome,
+                        p->num_fases, p->objetivo, i < NUM_PROTOCOLOS_EMBUTIDOS ? " (flash)" : "");
+             }
+         } else if (c == 'P' || c == 'p') {
+             lendo_protocolo = true;
+             tamanho = 0;
+         } else if (c == 'V' || c == 'v') {
+             gravar_vetores = !gravar_vetores;
+             printf("VETORES - Gravacao %s, rotulo %d\n", gravar_vetores ? "ligada" : "desligada", rotulo_gravacao);
+         } else if (c >= '0' && c < '0' + NUM_ESTADOS_COGNITIVOS) {
+             rotulo_gravacao = c - '0';
+             printf("VETORES - Rotulo: %s\n", classificador_nome((EstadoMental)rotulo_gravacao));
+         } else if (c == '-') {
+             rotulo_gravacao = -1;
+             printf("VETORES - Rotulo: estado das regras\n");
+         }
+     }
+ }
+ 
  //===============================================
  // Função principal
  //===============================================
@@ -1105,10 +2066,87 @@ void button_callback(uint gpio, uint32_t events) {
      gpio_pull_up(SDA);
      gpio_pull_up(SCL);
      
-     // Inicializa o ADC para os potenciômetros
-     adc_init();
-     adc_gpio_init(POT_ATENCAO_PIN);
-     adc_gpio_init(POT_RELAXAMENTO_PIN);
+     // Seleciona e inicia a fonte de canais; o restante do pipeline usa só a
+     // taxa, a faixa e o número de canais que ela informa
+ #if FONTE_ENTRADA == FONTE_ADS1299
+     fonte = ads1299_fonte();
+ #elif FONTE_ENTRADA == FONTE_SIMULADA
+     fonte = fonte_simulada_configurar(SIMULADA_NUM_CANAIS, SIMULADA_TAXA_HZ,
+                                       SEMENTE_FONTE_SIMULADA, time_us_64);
+ #else
+     fonte = aquisicao_fonte();
+ #endif
+     fonte->iniciar();
+     uint32_t taxa_hz = fonte->taxa_hz;
+     uint32_t faixa = (uint32_t)(fonte->maximo - fonte->minimo);
+     
+     // Calibração inicial: identidade até a primeira captura
+     if (fonte->definir_calibracao) {
+         for (int c = 0; c < fonte->num_canais; c++) {
+             calibracao_identidade(&calibracao[c], (uint16_t)fonte->maximo);
+             fonte->definir_calibracao(c, &calibracao[c]);
+         }
+     }
+     
+     // Escala da faixa da fonte para os níveis de atenção (0-100) e relaxamento (0-10)
+     fator_atencao = (uint32_t)((100ull << 32) / faixa);
+     fator_relaxamento = (uint32_t)((10ull << 32) / faixa);
+     
+     // Ruído determinístico das leituras
+     prng_semear(&prng_ruido, SEMENTE_RUIDO_NIVEIS);
+     
+     // Detectores de artefato por canal (limites em frações da faixa: para o
+     // ADC de 16 bits, trilhos a 64, saltos de 4096 no EEG e 8192 nos demais)
+     ConfigArtefato config_artefato_eeg = {
+         .trilho_inferior = fonte->minimo + (int32_t)(faixa >> 10),
+         .trilho_superior = fonte->maximo - (int32_t)(faixa >> 10),
+         .salto_max = (int32_t)(faixa >> 4),
+         .plano_tolerancia = (int32_t)(faixa >> 16) + 1,
+         .plano_amostras = taxa_hz / 20,   // 50 ms
+         .guarda = 8,
+     };
+     ConfigArtefato config_artefato_nivel = {
+         .trilho_inferior = INT32_MIN,
+         .trilho_superior = INT32_MAX,
+         .salto_max = (int32_t)(faixa >> 3),
+         .plano_tolerancia = 0,
+         .plano_amostras = 0,
+         .guarda = 8,
+     };
+     artefato_init(&artefato_eeg, &config_artefato_eeg);
+ #if CANAL_EEG_PAR >= 0
+     artefato_init(&artefato_eeg_par, &config_artefato_eeg);
+ #endif
+     for (int c = 0; c < fonte->num_canais; c++) {
+         artefato_init(&artefato_nivel[c], &config_artefato_nivel);
+     }
+     
+     // Tabelas da FFT e estado da análise espectral
+     espectro_init(taxa_hz);
+     espectro_canal_init(&espectro_eeg);
+ #if CANAL_EEG_PAR >= 0
+     espectro_canal_init(&espectro_eeg_par);
+ #endif
+     iniciar_metricas();
+     
+     // EEG sintético centrado no meio da faixa, com ruído 1/f de fundo
+     gerador_eeg_init(&gerador_eeg, taxa_hz, fonte->minimo + (int32_t)(faixa / 2), SEMENTE_GERADOR_EEG);
+     gerador_eeg_definir_ruido(&gerador_eeg, 300);
+     atualizar_gerador_eeg(&estado_atual);
+     
+     // Cascatas de pré-processamento por canal
+     biquad_cascata_init(&filtro_eeg);
+     biquad_cascata_adicionar(&filtro_eeg, biquad_projeto(FILTRO_PA_0_5HZ, taxa_hz));
+     biquad_cascata_adicionar(&filtro_eeg, biquad_projeto(FILTRO_REDE, taxa_hz));
+     biquad_cascata_adicionar(&filtro_eeg, biquad_projeto(FILTRO_PB_40HZ, taxa_hz));
+ #if CANAL_EEG_PAR >= 0
+     filtro_eeg_par = filtro_eeg;
+ #endif
+     for (int c = 0; c < fonte->num_canais; c++) {
+         biquad_cascata_init(&filtro_nivel[c]);
+         biquad_cascata_adicionar(&filtro_nivel[c], biquad_projeto(FILTRO_REDE, taxa_hz));
+         biquad_cascata_adicionar(&filtro_nivel[c], biquad_projeto(FILTRO_PB_5HZ, taxa_hz));
+     }
      
      // Inicializa os botões
      gpio_init(BUTTON_NEXT);
@@ -1137,6 +2175,9 @@ void button_callback(uint gpio, uint32_t events) {
      gpio_set_dir(BUZZER2_PIN, GPIO_OUT);
      gpio_put(BUZZER2_PIN, 0);
      
+     // Gerenciador de áudio: buzzer principal (feedback) e de alertas
+     audio_init(BUZZER1_PIN, BUZZER2_PIN);
+     
      // Inicializa o LED RGB
      init_rgb_led();
      
@@ -1153,14 +2194,38 @@ void button_callback(uint gpio, uint32_t events) {
      uint offset = pio_add_program(pio, &ws2812_program);
      ws2812_program_init(pio, sm, offset, WS2812_PIN, 800000, IS_RGBW);
      
+     classificador_init(&classificador, &config_classificador);
+     
      // Inicializa as estatísticas
+     quantil_init(&stats.dist_atencao, Q16_ZERO, Q16_INT(100));
+     quantil_init(&stats.dist_relaxamento, Q16_ZERO, Q16_INT(10));
+     tendencia_init(&tendencia);
+     sessoes_init(&sessoes);
      stats.tempo_inicio = time_us_32() / 1000000;
      
      // Mostra a tela de boas-vindas
      splash_screen(&ssd);
      
      // Loop principal
+     int tela_anterior = -2;
      while (true) {
+         // Outra tela ocupou o display e os LEDs: o monitoramento redesenha ao voltar
+         int tela = in_set_mode ? -1 : menu_index;
+         if (tela != tela_anterior) {
+             redesenhar_monitor = true;
+             tela_anterior = tela;
+         }
+         
+         // Interrompe o tom contínuo ao sair do modo de treinamento
+         if (in_set_mode || menu_index != 2) {
+             audio_feedback_parar();
+         }
+         
+         // Captura de calibração abandonada ao sair do parâmetro
+         if (etapa_calibracao >= 0 && (!in_set_mode || current_param != PARAM_CALIBRACAO)) {
+             cancelar_calibracao();
+         }
+         
          // Verifica em qual modo estamos e executa a função correspondente
          if (in_set_mode) {
              executar_modo_configuracao(&ssd);
@@ -1181,6 +2246,9 @@ void button_callback(uint gpio, uint32_t events) {
              }
          }
          
+         // Comandos pela serial
+         processar_comandos_serial();
+         
          // Pequeno delay para não sobrecarregar o processador
          sleep_ms(50);
      }
@@ -0,0 +1,21 @@
+#ifndef TESTE_H
+#define TESTE_H
+
+#include <stdio.h>
+
+// Verificações mínimas dos testes no host: cada falha é impressa com a
+// linha e o teste termina com código 1 se houve alguma.
+static int falhas_teste = 0;
+
+#define VERIFICAR(cond, ...) do { \
+    if (!(cond)) { \
+        printf("%s:%d: falhou: %s: ", __FILE__, __LINE__, #cond); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+        falhas_teste++; \
+    } \
+} while (0)
+
+#define RESULTADO_TESTE() (falhas_teste ? (printf("%d falha(s)\n", falhas_teste), 1) : (printf("ok\n"), 0))
+
+#endif
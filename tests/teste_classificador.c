@@ -0,0 +1,39 @@
+#include <stdint.h>
+#include "classificador.h"
+#include "teste.h"
+
+// Zonas do classificador com outro classificador decidindo o estado: elas
+// seguem os níveis com histerese, e a volta à tabela de regiões parte delas
+#define PASSO_US 100000u
+
+int main(void) {
+    const ConfigClassificador cfg = {
+        .histerese = {Q16_INT(5), Q16_INT(5), Q16_INT(5), Q16_INT(5)},
+    };
+    const q16_t limiares[NUM_LIMIARES] = {Q16_INT(30), Q16_INT(70), Q16_INT(30), Q16_INT(70)};
+    ClassificadorCognitivo c;
+    classificador_init(&c, &cfg);
+    EventoTransicao evento;
+    uint64_t agora_us = 0;
+
+    // O modelo insiste em "Normal" enquanto os níveis se movem
+    EstadoMental regiao = classificador_atualizar_zonas(&c, Q16_INT(80), Q16_INT(50), limiares);
+    classificador_aceitar(&c, ESTADO_NORMAL, agora_us += PASSO_US, &evento);
+    VERIFICAR(regiao == ESTADO_CONCENTRADO, "atencao 80, relaxamento 50: %s", classificador_nome(regiao));
+
+    // 67 está na faixa de histerese do limiar alto: a atenção continua alta
+    regiao = classificador_atualizar_zonas(&c, Q16_INT(67), Q16_INT(50), limiares);
+    classificador_aceitar(&c, ESTADO_NORMAL, agora_us += PASSO_US, &evento);
+    VERIFICAR(regiao == ESTADO_CONCENTRADO, "atencao 67 depois de 80: %s", classificador_nome(regiao));
+
+    regiao = classificador_atualizar_zonas(&c, Q16_INT(50), Q16_INT(80), limiares);
+    classificador_aceitar(&c, ESTADO_NORMAL, agora_us += PASSO_US, &evento);
+    VERIFICAR(regiao == ESTADO_RELAXADO, "atencao 50, relaxamento 80: %s", classificador_nome(regiao));
+    VERIFICAR(c.estado == ESTADO_NORMAL, "estado %s com o modelo decidindo", classificador_nome(c.estado));
+
+    // Volta às regras: 67 vindo da zona média não cruza o limiar alto
+    bool mudou = classificador_atualizar(&c, Q16_INT(67), Q16_INT(80), limiares, agora_us += PASSO_US, &evento);
+    VERIFICAR(mudou && c.estado == ESTADO_RELAXADO && evento.de == ESTADO_NORMAL,
+              "volta as regras: %s", classificador_nome(c.estado));
+    return RESULTADO_TESTE();
+}
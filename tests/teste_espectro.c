@@ -0,0 +1,124 @@
+#include <math.h>
+#include <stdint.h>
+#include "espectro.h"
+#include "teste.h"
+
+// Compara a FFT Q15 e a divisão em bandas com uma DFT em double sobre o
+// mesmo bloco (média removida, janela de Hann, mesmos bins por banda).
+#define BLOCOS 6
+#define TOTAL_AMOSTRAS (ESPECTRO_N + (BLOCOS - 1) * ESPECTRO_SALTO)
+
+// Tolerâncias: fração por banda em décimos de % e erro relativo da potência
+// absoluta das bandas com pelo menos 5% do total
+#define TOL_RELATIVA 10
+#define TOL_POTENCIA 0.05
+
+typedef struct {
+    const char *nome;
+    double dc;
+    double freq_hz[4];
+    double amplitude[4];
+    double ruido;
+} Sinal;
+
+static const Sinal sinais[] = {
+    {"delta 2 Hz",        30000, {2.0},                  {2000},                   0},
+    {"theta 6 Hz",        30000, {6.0},                  {2000},                   0},
+    {"alpha 10 Hz",       30000, {10.0},                 {2000},                   0},
+    {"beta 20 Hz",        30000, {20.0},                 {2000},                   0},
+    {"mistura",           30000, {2.5, 5.5, 10.5, 17.0}, {800, 600, 700, 500},     0},
+    {"mistura + ruido",   30000, {1.5, 7.0, 9.0, 25.0},  {600, 400, 1500, 300},    300},
+    {"amplitude baixa",   100,   {3.0, 11.0},            {12, 9},                  2},
+    {"amplitude alta",    0,     {6.5, 14.0},            {3.0e6, 2.0e6},           1.0e5},
+};
+
+static uint32_t semente = 12345;
+
+// Ruído uniforme simples, só para o teste
+static double ruido(double amplitude) {
+    semente = semente * 1664525u + 1013904223u;
+    return amplitude * ((double)(semente >> 8) / (double)(1u << 24) * 2.0 - 1.0);
+}
+
+static uint32_t bin_banda(double hz, uint32_t taxa_hz) {
+    uint32_t k = (uint32_t)ceil(hz * ESPECTRO_N / taxa_hz - 1e-9);
+    if (k < 1) k = 1;
+    if (k > ESPECTRO_N / 2) k = ESPECTRO_N / 2;
+    return k;
+}
+
+static void referencia(const int32_t *x, uint32_t taxa_hz, double potencia[ESPECTRO_NUM_BANDAS]) {
+    static const double limites[ESPECTRO_NUM_BANDAS][2] = {{0.5, 4}, {4, 8}, {8, 12}, {12, 30}};
+    // Mesma média inteira do módulo: a fração descartada é parte do sinal
+    int64_t soma = 0;
+    for (uint32_t n = 0; n < ESPECTRO_N; n++) soma += x[n];
+    int32_t media = (int32_t)(soma / ESPECTRO_N);
+
+    for (int b = 0; b < ESPECTRO_NUM_BANDAS; b++) {
+        potencia[b] = 0;
+        uint32_t ini = bin_banda(limites[b][0], taxa_hz);
+        uint32_t fim = bin_banda(limites[b][1], taxa_hz);
+        for (uint32_t k = ini; k < fim; k++) {
+            double re = 0, im = 0;
+            for (uint32_t n = 0; n < ESPECTRO_N; n++) {
+                double w = 0.5 - 0.5 * cos(2.0 * M_PI * n / ESPECTRO_N);
+                double v = (x[n] - media) * w;
+                re += v * cos(2.0 * M_PI * k * n / ESPECTRO_N);
+                im -= v * sin(2.0 * M_PI * k * n / ESPECTRO_N);
+            }
+            potencia[b] += re * re + im * im;
+        }
+    }
+}
+
+static void testar(const Sinal *s, uint32_t taxa_hz) {
+    static int32_t x[TOTAL_AMOSTRAS];
+    for (uint32_t n = 0; n < TOTAL_AMOSTRAS; n++) {
+        double v = s->dc + ruido(s->ruido);
+        for (int i = 0; i < 4; i++) {
+            v += s->amplitude[i] * sin(2.0 * M_PI * s->freq_hz[i] * n / taxa_hz + i);
+        }
+        x[n] = (int32_t)lround(v);
+    }
+
+    espectro_init(taxa_hz);
+    Espectro e;
+    espectro_canal_init(&e);
+    uint32_t bloco = 0;
+    for (uint32_t n = 0; n < TOTAL_AMOSTRAS; n++) {
+        if (!espectro_adicionar(&e, x[n])) continue;
+        ResultadoBandas r;
+        espectro_calcular(&e, &r);
+
+        // O bloco calculado é o das últimas N amostras
+        double ref[ESPECTRO_NUM_BANDAS], total = 0;
+        referencia(&x[n + 1 - ESPECTRO_N], taxa_hz, ref);
+        for (int b = 0; b < ESPECTRO_NUM_BANDAS; b++) total += ref[b];
+
+        for (int b = 0; b < ESPECTRO_NUM_BANDAS; b++) {
+            double esperada = total > 0 ? 1000.0 * ref[b] / total : 0;
+            VERIFICAR(fabs(r.relativa[b] - esperada) <= TOL_RELATIVA,
+                      "%s, %u Hz, bloco %u, banda %d: relativa %u, esperada %.1f",
+                      s->nome, taxa_hz, bloco, b, r.relativa[b], esperada);
+
+            if (esperada >= 50) {
+                double potencia = ldexp((double)r.potencia[b], 2 * r.expoente);
+                double erro = fabs(potencia - ref[b]) / ref[b];
+                VERIFICAR(erro <= TOL_POTENCIA, "%s, %u Hz, bloco %u, banda %d: potencia %.4g, esperada %.4g",
+                          s->nome, taxa_hz, bloco, b, potencia, ref[b]);
+            }
+        }
+        bloco++;
+    }
+    VERIFICAR(bloco == BLOCOS, "%s, %u Hz: %u blocos, esperados %u", s->nome, taxa_hz, bloco, BLOCOS);
+}
+
+int main(void) {
+    static const uint32_t taxas[] = {250, 500, 1000};
+    for (uint32_t t = 0; t < sizeof(taxas) / sizeof(taxas[0]); t++) {
+        for (uint32_t i = 0; i < sizeof(sinais) / sizeof(sinais[0]); i++) {
+            testar(&sinais[i], taxas[t]);
+        }
+    }
+    return RESULTADO_TESTE();
+}
@@ -0,0 +1,89 @@
+#include <math.h>
+#include <stdint.h>
+#include "estatistica.h"
+#include "prng.h"
+#include "teste.h"
+
+// Estatística online contra uma referência em double sobre milhões de
+// amostras: média exata (no máximo 1 LSB do Q16.16), variância amostral,
+// desvio, mínimo e máximo, e uma média que ainda se move depois de milhões
+// de amostras iguais
+#define AMOSTRAS 4000000u
+#define LSB (1.0 / 65536.0)
+
+static double q16_para_double(q16_t v) {
+    return v.bruto * LSB;
+}
+
+// Confere o acumulado contra a média e a variância amostral em double
+static void comparar(const EstatisticaOnline *e, double media, double variancia, const char *caso) {
+    double m = q16_para_double(e->media);
+    double v = q16_para_double(estatistica_variancia(e));
+    double d = q16_para_double(estatistica_desvio(e));
+    VERIFICAR(fabs(m - media) <= LSB, "%s: media %.7f, referencia %.7f", caso, m, media);
+    VERIFICAR(fabs(v - variancia) <= variancia * 1e-4, "%s: variancia %.5f, referencia %.5f", caso, v, variancia);
+    VERIFICAR(fabs(d - sqrt(variancia)) <= sqrt(variancia) * 1e-4, "%s: desvio %.5f, referencia %.5f",
+              caso, d, sqrt(variancia));
+}
+
+// Níveis de atenção gaussianos em torno de 50 com desvio 10, limitados a 0-100
+static void testar_aleatorio(void) {
+    EstatisticaOnline e;
+    estatistica_zerar(&e);
+    Prng p;
+    prng_semear(&p, 0x5EED1234u);
+
+    // Welford em double como referência
+    double media = 0, m2 = 0;
+    q16_t minimo = Q16_INT(100), maximo = Q16_ZERO;
+    for (uint32_t i = 0; i < AMOSTRAS; i++) {
+        q16_t x = q16_limitar(Q16_BRUTO(50 * 65536 + prng_gaussiano_q12(&p) * 160), Q16_ZERO, Q16_INT(100));
+        estatistica_adicionar(&e, x);
+        minimo = q16_min(minimo, x);
+        maximo = q16_max(maximo, x);
+        double v = q16_para_double(x);
+        double delta = v - media;
+        media += delta / (i + 1);
+        m2 += delta * (v - media);
+    }
+    VERIFICAR(e.amostras == AMOSTRAS, "%u amostras", e.amostras);
+    comparar(&e, media, m2 / (AMOSTRAS - 1), "gaussiana");
+    VERIFICAR(q16_comparar(e.minimo, minimo) == 0 && q16_comparar(e.maximo, maximo) == 0,
+              "faixa %.4f-%.4f, esperada %.4f-%.4f", q16_para_float(e.minimo), q16_para_float(e.maximo),
+              q16_para_float(minimo), q16_para_float(maximo));
+}
+
+// 3 milhões de amostras em 10 e 1 milhão em 90: a média chega a 30 exatos
+// e a variância amostral é 3/16 * 6400 * n / (n - 1)
+static void testar_degrau(void) {
+    EstatisticaOnline e;
+    estatistica_zerar(&e);
+    const uint32_t n1 = AMOSTRAS / 4 * 3;
+    for (uint32_t i = 0; i < AMOSTRAS; i++) {
+        estatistica_adicionar(&e, i < n1 ? Q16_INT(10) : Q16_INT(90));
+    }
+    VERIFICAR(q16_comparar(e.media, Q16_INT(30)) == 0, "degrau: media %.7f", q16_para_float(e.media));
+    comparar(&e, 30.0, 6400.0 * 3 / 16 * AMOSTRAS / (AMOSTRAS - 1), "degrau");
+    VERIFICAR(q16_comparar(e.minimo, Q16_INT(10)) == 0 && q16_comparar(e.maximo, Q16_INT(90)) == 0,
+              "degrau: faixa %.2f-%.2f", q16_para_float(e.minimo), q16_para_float(e.maximo));
+}
+
+// Sem amostras suficientes a variância é zero
+static void testar_poucas(void) {
+    EstatisticaOnline e;
+    estatistica_zerar(&e);
+    VERIFICAR(estatistica_variancia(&e).bruto == 0, "variancia sem amostras");
+    estatistica_adicionar(&e, Q16_CONST(42.5));
+    VERIFICAR(q16_comparar(e.media, Q16_CONST(42.5)) == 0 && estatistica_variancia(&e).bruto == 0 &&
+              q16_comparar(e.minimo, e.maximo) == 0, "uma amostra: media %.4f", q16_para_float(e.media));
+    estatistica_adicionar(&e, Q16_CONST(44.5));
+    VERIFICAR(q16_comparar(estatistica_variancia(&e), Q16_INT(2)) == 0, "duas amostras: variancia %.4f",
+              q16_para_float(estatistica_variancia(&e)));
+}
+
+int main(void) {
+    testar_aleatorio();
+    testar_degrau();
+    testar_poucas();
+    return RESULTADO_TESTE();
+}
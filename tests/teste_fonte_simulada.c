@@ -0,0 +1,166 @@
+#include <stdint.h>
+#include "fonte_simulada.h"
+#include "espectro.h"
+#include "teste.h"
+
+// Fonte simulada lida pelo anel de quadros com um relógio de teste:
+// quantidade de quadros, carimbos de tempo, faixa, estouros e a diferença
+// de alpha entre canais pares e ímpares
+#define NUM_CANAIS 4
+#define SEMENTE 0x53494D31u
+#define INICIO_US 5000000u
+
+static uint64_t agora_us;
+
+static uint64_t relogio_teste(void) {
+    return agora_us;
+}
+
+typedef struct {
+    Espectro espectro;
+    uint32_t blocos;
+    uint32_t soma_alpha;    // Décimos de %
+} EspectroCanal;
+
+typedef struct {
+    uint32_t quadros;
+    uint64_t proximo_instante_us;
+    bool fora_de_ordem;
+    bool fora_da_faixa;
+} Leitura;
+
+// Consome tudo o que está no anel conferindo a sequência dos carimbos
+static void consumir(const FonteCanais *f, Leitura *l, uint32_t periodo_us, EspectroCanal *espectros) {
+    QuadroAmostras *q;
+    uint32_t n;
+    while ((n = anel_trecho(f->anel, &q, FONTE_QUADROS_BLOCO)) > 0) {
+        for (uint32_t i = 0; i < n; i++) {
+            if (q[i].instante_us != l->proximo_instante_us) l->fora_de_ordem = true;
+            l->proximo_instante_us = q[i].instante_us + periodo_us;
+            for (uint8_t c = 0; c < f->num_canais; c++) {
+                if (q[i].canais[c] < f->minimo || q[i].canais[c] > f->maximo) l->fora_da_faixa = true;
+                if (espectros && espectro_adicionar(&espectros[c].espectro, q[i].canais[c])) {
+                    ResultadoBandas r;
+                    espectro_calcular(&espectros[c].espectro, &r);
+                    espectros[c].soma_alpha += r.relativa[BANDA_ALPHA];
+                    espectros[c].blocos++;
+                }
+            }
+        }
+        l->quadros += n;
+        anel_consumir(f->anel, n);
+    }
+}
+
+static void testar_taxa(uint32_t taxa_hz) {
+    const FonteCanais *f = fonte_simulada_configurar(NUM_CANAIS, taxa_hz, SEMENTE, relogio_teste);
+    const uint32_t periodo_us = 1000000u / taxa_hz;
+    const uint32_t bloco_us = periodo_us * FONTE_QUADROS_BLOCO;
+    VERIFICAR(f->num_canais == NUM_CANAIS && f->taxa_hz == taxa_hz, "%u Hz: fonte %u canais, %u Hz",
+              taxa_hz, f->num_canais, f->taxa_hz);
+
+    agora_us = INICIO_US;
+    f->iniciar();
+    Leitura l = {.proximo_instante_us = INICIO_US};
+
+    // Consumo em dia, em passos que não coincidem com os blocos: só blocos
+    // inteiros já vencidos aparecem, na ordem e sem lacunas
+    espectro_init(taxa_hz);
+    EspectroCanal espectros[NUM_CANAIS] = {0};
+    for (int c = 0; c < NUM_CANAIS; c++) espectro_canal_init(&espectros[c].espectro);
+    for (uint32_t passo = 0; passo < 200; passo++) {
+        agora_us += 7300;
+        f->produzir();
+        consumir(f, &l, periodo_us, espectros);
+        uint32_t esperados = (uint32_t)((agora_us - INICIO_US) / bloco_us) * FONTE_QUADROS_BLOCO;
+        VERIFICAR(l.quadros == esperados, "%u Hz, passo %u: %u quadros, esperados %u",
+                  taxa_hz, passo, l.quadros, esperados);
+        if (l.quadros != esperados) break;
+    }
+    VERIFICAR(!l.fora_de_ordem, "%u Hz: carimbos fora de sequência", taxa_hz);
+    VERIFICAR(!l.fora_da_faixa, "%u Hz: amostras fora de [%d, %d]", taxa_hz, f->minimo, f->maximo);
+    VERIFICAR(f->anel->estouros == 0, "%u Hz: %u estouros com consumo em dia", taxa_hz, f->anel->estouros);
+
+    // Canais ímpares têm alpha mais forte (1500 contra 700)
+    for (int c = 0; c + 1 < NUM_CANAIS; c += 2) {
+        VERIFICAR(espectros[c].blocos > 0 && espectros[c].blocos == espectros[c + 1].blocos,
+                  "%u Hz, canais %d e %d: %u e %u blocos", taxa_hz, c, c + 1, espectros[c].blocos,
+                  espectros[c + 1].blocos);
+        VERIFICAR(espectros[c + 1].soma_alpha > espectros[c].soma_alpha, "%u Hz: alpha do canal %d %u, do canal %d %u",
+                  taxa_hz, c + 1, espectros[c + 1].soma_alpha, c, espectros[c].soma_alpha);
+    }
+
+    // Consumidor parado por menos que a lacuna máxima: os blocos são gerados
+    // e o que não cabe no anel é descartado por anel_reservar
+    agora_us = INICIO_US + (uint64_t)(l.quadros / FONTE_QUADROS_BLOCO) * bloco_us;
+    uint32_t blocos_pendentes = FONTE_CAPACIDADE_ANEL / FONTE_QUADROS_BLOCO - 2;
+    agora_us += (uint64_t)blocos_pendentes * bloco_us;
+    f->produzir();
+    agora_us += 4 * (uint64_t)bloco_us;
+    f->produzir();
+    uint32_t excesso = (blocos_pendentes + 4) * FONTE_QUADROS_BLOCO - FONTE_CAPACIDADE_ANEL;
+    VERIFICAR(anel_ocupacao(f->anel) == FONTE_CAPACIDADE_ANEL, "%u Hz: ocupação %u", taxa_hz,
+              anel_ocupacao(f->anel));
+    VERIFICAR(f->anel->estouros == excesso, "%u Hz: %u estouros, esperados %u", taxa_hz, f->anel->estouros, excesso);
+
+    Leitura cheia = {.proximo_instante_us = l.proximo_instante_us};
+    consumir(f, &cheia, periodo_us, NULL);
+    VERIFICAR(cheia.quadros == FONTE_CAPACIDADE_ANEL && !cheia.fora_de_ordem,
+              "%u Hz: %u quadros após encher o anel", taxa_hz, cheia.quadros);
+
+    // Consumidor parado por muito tempo: os blocos vencidos além da
+    // capacidade nem são gerados, contam como estouro, e a leitura retoma
+    // com os mais recentes
+    uint32_t estouros_antes = f->anel->estouros;
+    uint64_t retomada_us = agora_us;
+    agora_us += 3000000u;
+    f->produzir();
+    uint32_t vencidos = (uint32_t)((agora_us - INICIO_US) / bloco_us) -
+                        (uint32_t)((retomada_us - INICIO_US) / bloco_us);
+    uint32_t descartados = vencidos * FONTE_QUADROS_BLOCO - FONTE_CAPACIDADE_ANEL;
+    VERIFICAR(f->anel->estouros - estouros_antes == descartados, "%u Hz: %u estouros na lacuna, esperados %u",
+              taxa_hz, f->anel->estouros - estouros_antes, descartados);
+
+    uint64_t ultimo_bloco_us = INICIO_US + ((agora_us - INICIO_US) / bloco_us) * bloco_us;
+    Leitura lacuna = {.proximo_instante_us = ultimo_bloco_us - (uint64_t)FONTE_CAPACIDADE_ANEL * periodo_us};
+    consumir(f, &lacuna, periodo_us, NULL);
+    VERIFICAR(lacuna.quadros == FONTE_CAPACIDADE_ANEL && !lacuna.fora_de_ordem,
+              "%u Hz: %u quadros após a lacuna", taxa_hz, lacuna.quadros);
+    VERIFICAR(lacuna.proximo_instante_us == ultimo_bloco_us, "%u Hz: último carimbo %llu, esperado %llu",
+              taxa_hz, (unsigned long long)lacuna.proximo_instante_us, (unsigned long long)ultimo_bloco_us);
+}
+
+// A mesma semente reproduz as amostras; taxas fora da faixa são limitadas
+static void testar_configuracao(void) {
+    int32_t primeiras[2][NUM_CANAIS];
+    for (int rodada = 0; rodada < 2; rodada++) {
+        const FonteCanais *f = fonte_simulada_configurar(NUM_CANAIS, 250, SEMENTE, relogio_teste);
+        agora_us = INICIO_US;
+        f->iniciar();
+        agora_us += 1000000u;
+        f->produzir();
+        QuadroAmostras *q;
+        uint32_t n = anel_trecho(f->anel, &q, 1);
+        VERIFICAR(n == 1, "rodada %d: anel vazio", rodada);
+        for (int c = 0; c < NUM_CANAIS; c++) primeiras[rodada][c] = n ? q->canais[c] : 0;
+    }
+    for (int c = 0; c < NUM_CANAIS; c++) {
+        VERIFICAR(primeiras[0][c] == primeiras[1][c], "canal %d: %d e %d com a mesma semente",
+                  c, primeiras[0][c], primeiras[1][c]);
+    }
+    VERIFICAR(primeiras[0][0] != primeiras[0][1], "canais 0 e 1 iguais");
+
+    VERIFICAR(fonte_simulada_configurar(NUM_CANAIS, 100, SEMENTE, relogio_teste)->taxa_hz == FONTE_SIMULADA_TAXA_MIN,
+              "taxa abaixo do mínimo");
+    VERIFICAR(fonte_simulada_configurar(NUM_CANAIS, 4000, SEMENTE, relogio_teste)->taxa_hz == FONTE_SIMULADA_TAXA_MAX,
+              "taxa acima do máximo");
+    VERIFICAR(fonte_simulada_configurar(20, 500, SEMENTE, relogio_teste)->num_canais == FONTE_MAX_CANAIS,
+              "canais acima do máximo");
+}
+
+int main(void) {
+    testar_taxa(250);
+    testar_taxa(1000);
+    testar_configuracao();
+    return RESULTADO_TESTE();
+}
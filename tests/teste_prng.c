@@ -0,0 +1,95 @@
+#include <math.h>
+#include <stdint.h>
+#include "prng.h"
+#include "teste.h"
+
+// Sequência conhecida do xorshift32 (13, 17, 5), faixas e momentos das
+// distribuições derivadas
+#define AMOSTRAS 1000000
+
+static void testar_sequencia(void) {
+    // Saídas de referência do xorshift32 de Marsaglia com semente 1
+    static const uint32_t esperados[] = {270369u, 67634689u, 2647435461u, 307599695u, 2398689233u};
+    Prng p;
+    prng_semear(&p, 1);
+    for (uint32_t i = 0; i < sizeof(esperados) / sizeof(esperados[0]); i++) {
+        uint32_t v = prng_proximo(&p);
+        VERIFICAR(v == esperados[i], "saida %u: %u, esperada %u", i, v, esperados[i]);
+    }
+
+    // Semente zero vira a padrão (o zero é absorvente)
+    Prng zero, padrao;
+    prng_semear(&zero, 0);
+    prng_semear(&padrao, PRNG_SEMENTE_PADRAO);
+    for (int i = 0; i < 3; i++) {
+        uint32_t a = prng_proximo(&zero), b = prng_proximo(&padrao);
+        VERIFICAR(a == b && a != 0, "semente zero, saida %d: %u, padrao %u", i, a, b);
+    }
+    prng_semear(&p, PRNG_SEMENTE_PADRAO);
+    VERIFICAR(prng_proximo(&p) == 0xE124B63Au, "primeira saida da semente padrao");
+}
+
+static void testar_uniforme(void) {
+    Prng p;
+    prng_semear(&p, 12345);
+    int32_t minimo = INT32_MAX, maximo = INT32_MIN;
+    double soma = 0, soma2 = 0;
+    for (uint32_t i = 0; i < AMOSTRAS; i++) {
+        int32_t v = prng_uniforme_q15(&p);
+        if (v < minimo) minimo = v;
+        if (v > maximo) maximo = v;
+        soma += v;
+        soma2 += (double)v * v;
+    }
+    double media = soma / AMOSTRAS;
+    double desvio = sqrt(soma2 / AMOSTRAS - media * media);
+    // Uniforme discreta em [-32768, 32767]: média -0.5, desvio 65536 / sqrt(12)
+    double desvio_esperado = 65536.0 / sqrt(12.0);
+    VERIFICAR(minimo >= -32768 && maximo <= 32767, "faixa [%d, %d]", minimo, maximo);
+    VERIFICAR(minimo < -32700 && maximo > 32700, "extremos nao alcancados: [%d, %d]", minimo, maximo);
+    VERIFICAR(fabs(media + 0.5) < 5 * desvio_esperado / sqrt(AMOSTRAS), "media %.2f", media);
+    VERIFICAR(fabs(desvio / desvio_esperado - 1) < 0.01, "desvio %.1f, esperado %.1f", desvio, desvio_esperado);
+
+    uint32_t contagem[10] = {0};
+    for (uint32_t i = 0; i < AMOSTRAS; i++) {
+        uint32_t v = prng_intervalo(&p, 10);
+        VERIFICAR(v < 10, "intervalo: %u", v);
+        if (v < 10) contagem[v]++;
+    }
+    for (int i = 0; i < 10; i++) {
+        VERIFICAR(fabs(contagem[i] - AMOSTRAS / 10.0) < 0.01 * AMOSTRAS / 10.0, "intervalo %d: %u", i, contagem[i]);
+    }
+}
+
+static void testar_gaussiano(void) {
+    Prng p;
+    prng_semear(&p, 777);
+    // Soma de quatro uniformes limitada a 2 * 65535 * 7094 / 65536
+    const int32_t limite = (2 * 65535 * 7094) >> 16;
+    int32_t minimo = INT32_MAX, maximo = INT32_MIN;
+    double soma = 0, soma2 = 0;
+    uint32_t fora_1_desvio = 0;
+    for (uint32_t i = 0; i < AMOSTRAS; i++) {
+        int32_t v = prng_gaussiano_q12(&p);
+        if (v < minimo) minimo = v;
+        if (v > maximo) maximo = v;
+        soma += v;
+        soma2 += (double)v * v;
+        if (v > 4096 || v < -4096) fora_1_desvio++;
+    }
+    double media = soma / AMOSTRAS;
+    double desvio = sqrt(soma2 / AMOSTRAS - media * media);
+    VERIFICAR(minimo >= -limite - 1 && maximo <= limite, "faixa [%d, %d], limite %d", minimo, maximo, limite);
+    VERIFICAR(fabs(media) < 5 * 4096.0 / sqrt(AMOSTRAS), "media %.2f", media);
+    VERIFICAR(fabs(desvio / 4096.0 - 1) < 0.01, "desvio %.1f, esperado 4096", desvio);
+    // Normal: ~31.7% fora de um desvio; Irwin-Hall com 4 termos fica perto
+    double fracao = (double)fora_1_desvio / AMOSTRAS;
+    VERIFICAR(fracao > 0.29 && fracao < 0.34, "fracao fora de 1 desvio %.3f", fracao);
+}
+
+int main(void) {
+    testar_sequencia();
+    testar_uniforme();
+    testar_gaussiano();
+    return RESULTADO_TESTE();
+}
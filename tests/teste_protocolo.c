@@ -0,0 +1,61 @@
+#include <stdint.h>
+#include "protocolo.h"
+#include "teste.h"
+
+// Interpretador de protocolos: leitura do texto, sinais usados e sinais sem
+// valor válido, que nunca contam como no alvo
+#define PASSO_US 100000u
+
+int main(void) {
+    Protocolo p;
+    VERIFICAR(protocolo_interpretar_texto("TBR 3 -:30:0:0:- T<2.5:300:9:50:CNF", &p), "protocolo valido recusado");
+    VERIFICAR(p.num_fases == 2 && p.objetivo == 3, "%u fases, objetivo %u", p.num_fases, p.objetivo);
+    VERIFICAR(protocolo_sinais_usados(&p) == PROTOCOLO_BIT_SINAL(SINAL_THETA_BETA), "sinais usados 0x%x",
+              protocolo_sinais_usados(&p));
+    VERIFICAR(!protocolo_interpretar_texto("X 9 A>1:10:1:1:-", &p), "objetivo fora da faixa aceito");
+    VERIFICAR(!protocolo_interpretar_texto("X 0 T^:10:1:1:-", &p), "alvo adaptativo em theta/beta aceito");
+
+    // Theta/beta abaixo de 2.5 logo após a linha de base
+    VERIFICAR(protocolo_interpretar_texto("TBR 0 -:1:0:0:- T<2.5:300:2:20:N", &p), "protocolo curto recusado");
+    ExecucaoProtocolo e;
+    uint64_t agora_us = 0;
+    protocolo_iniciar(&e, &p, agora_us);
+    q16_t sinais[NUM_SINAIS_PROTOCOLO] = {{0}};
+    const q16_t alvos[NUM_SINAIS_PROTOCOLO] = {{0}};
+    const uint32_t sem_metricas = PROTOCOLO_BIT_SINAL(SINAL_ATENCAO) | PROTOCOLO_BIT_SINAL(SINAL_RELAXAMENTO);
+    const uint32_t todos = sem_metricas | PROTOCOLO_BIT_SINAL(SINAL_THETA_BETA);
+
+    uint8_t eventos = 0;
+    while (e.fase == 0 && agora_us < 2000000u) {
+        agora_us += PASSO_US;
+        eventos |= protocolo_passo(&e, sinais, alvos, sem_metricas, PASSO_US, agora_us);
+    }
+    VERIFICAR(e.fase == 1 && (eventos & EVENTO_PROTOCOLO_FASE), "linha de base nao terminou");
+
+    // Theta/beta ainda sem avaliação lê 0, que está abaixo do limiar, mas
+    // não pode pontuar
+    for (int i = 0; i < 50; i++) {
+        agora_us += PASSO_US;
+        protocolo_passo(&e, sinais, alvos, sem_metricas, PASSO_US, agora_us);
+        VERIFICAR(!e.no_alvo, "passo %d no alvo com theta/beta invalido", i);
+    }
+    VERIFICAR(e.pontuacao == 0 && e.nivel == 1, "pontuacao %u, nivel %u sem sinal valido", e.pontuacao, e.nivel);
+
+    // Com valor válido abaixo do limiar pontua; acima, não
+    sinais[SINAL_THETA_BETA] = Q16_CONST(3.0);
+    agora_us += PASSO_US;
+    protocolo_passo(&e, sinais, alvos, todos, PASSO_US, agora_us);
+    VERIFICAR(!e.no_alvo, "theta/beta 3.0 no alvo");
+
+    sinais[SINAL_THETA_BETA] = Q16_CONST(1.2);
+    eventos = 0;
+    for (int i = 0; i < 20 && e.status == PROTOCOLO_EM_ANDAMENTO; i++) {
+        agora_us += PASSO_US;
+        eventos |= protocolo_passo(&e, sinais, alvos, todos, PASSO_US, agora_us);
+        VERIFICAR(e.no_alvo, "passo %d fora do alvo com theta/beta 1.2", i);
+    }
+    // 2 níveis de 20 pontos de 50 ms: 2 s no alvo
+    VERIFICAR(e.status == PROTOCOLO_CONCLUIDO && (eventos & EVENTO_PROTOCOLO_CONCLUIDO) && e.nivel == 3,
+              "status %u, nivel %u, pontuacao %u", e.status, e.nivel, e.pontuacao);
+    return RESULTADO_TESTE();
+}
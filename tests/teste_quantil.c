@@ -0,0 +1,69 @@
+#include <math.h>
+#include <stdint.h>
+#include "quantil.h"
+#include "teste.h"
+
+// Quantis do histograma contra distribuições conhecidas, com erro de no
+// máximo um bin (100 / 256 na faixa de 0 a 100 da atenção), e os casos de
+// borda: histograma vazio, todas as amostras num bin e valores fora da faixa
+#define AMOSTRAS 100000u
+
+static HistogramaQuantil h;
+
+static void verificar_quantil(uint16_t milesimos, double esperado, const char *caso) {
+    double largura = q16_para_float(h.largura_bin);
+    double q = q16_para_float(quantil_consultar(&h, milesimos));
+    VERIFICAR(fabs(q - esperado) <= largura, "%s, %u milesimos: %.4f, esperado %.4f (bin %.4f)",
+              caso, milesimos, q, esperado, largura);
+}
+
+// Rampa uniforme de 0 a 100 e a mesma rampa ao quadrado (quantil p em
+// 100 p^2), que concentra as amostras nos bins baixos
+static void testar_distribuicoes(void) {
+    quantil_init(&h, Q16_ZERO, Q16_INT(100));
+    for (uint32_t i = 0; i < AMOSTRAS; i++) {
+        quantil_adicionar(&h, q16_fracao((int32_t)(i * 100u), AMOSTRAS));
+    }
+    VERIFICAR(h.total == AMOSTRAS, "%u amostras", h.total);
+    verificar_quantil(100, 10.0, "uniforme");
+    verificar_quantil(500, 50.0, "uniforme");
+    verificar_quantil(900, 90.0, "uniforme");
+
+    quantil_zerar(&h);
+    for (uint32_t i = 0; i < AMOSTRAS; i++) {
+        double p = (double)i / AMOSTRAS;
+        quantil_adicionar(&h, Q16_BRUTO(100.0 * p * p * 65536.0));
+    }
+    verificar_quantil(100, 1.0, "quadratica");
+    verificar_quantil(500, 25.0, "quadratica");
+    verificar_quantil(900, 81.0, "quadratica");
+}
+
+static void testar_bordas(void) {
+    // Vazio: o início da faixa
+    quantil_init(&h, Q16_ZERO, Q16_INT(10));
+    VERIFICAR(quantil_consultar(&h, 500).bruto == 0, "mediana do vazio %.4f",
+              q16_para_float(quantil_consultar(&h, 500)));
+
+    // Um só valor: todo quantil cai no bin dele
+    for (int i = 0; i < 1000; i++) quantil_adicionar(&h, Q16_CONST(3.7));
+    verificar_quantil(0, 3.7, "um bin");
+    verificar_quantil(100, 3.7, "um bin");
+    verificar_quantil(500, 3.7, "um bin");
+    verificar_quantil(1000, 3.7, "um bin");
+
+    // Fora da faixa: os valores vão aos bins das pontas
+    quantil_zerar(&h);
+    for (int i = 0; i < 100; i++) {
+        quantil_adicionar(&h, Q16_INT(-5));
+        quantil_adicionar(&h, Q16_INT(50));
+    }
+    verificar_quantil(100, 0.0, "fora da faixa");
+    verificar_quantil(900, 10.0, "fora da faixa");
+}
+
+int main(void) {
+    testar_distribuicoes();
+    testar_bordas();
+    return RESULTADO_TESTE();
+}
@@ -0,0 +1,54 @@
+#include <stdint.h>
+#include "tendencia.h"
+#include "teste.h"
+
+// Resumo de janelas sobre uma rampa de 0 a 99, um valor por segundo: o
+// mínimo e o máximo têm de vir de dentro da janela
+static Tendencia tendencia;
+
+static void verificar_resumo(uint32_t janela_s, int32_t minimo, int32_t maximo) {
+    PontoTendencia p = tendencia_resumo(&tendencia, 0, janela_s);
+    VERIFICAR(p.valido, "janela %u s sem dados", janela_s);
+    VERIFICAR(q16_comparar(p.minimo, Q16_INT(minimo)) == 0 && q16_comparar(p.maximo, Q16_INT(maximo)) == 0,
+              "janela %u s: %.2f-%.2f, esperado %d-%d", janela_s, q16_para_float(p.minimo),
+              q16_para_float(p.maximo), minimo, maximo);
+}
+
+int main(void) {
+    tendencia_init(&tendencia);
+    for (int32_t i = 0; i < 100; i++) {
+        const q16_t valores[TENDENCIA_NUM_CANAIS] = {Q16_INT(i), Q16_INT(100 - i)};
+        tendencia_adicionar(&tendencia, (uint64_t)i * 1000000u, valores);
+    }
+
+    verificar_resumo(1, 99, 99);
+    verificar_resumo(5, 95, 99);
+    verificar_resumo(10, 90, 99);
+
+    // Janelas que não são múltiplas do balde: o trecho antes do primeiro
+    // balde grosso que cabe vem dos níveis mais finos
+    verificar_resumo(15, 85, 99);
+    verificar_resumo(61, 39, 99);
+    verificar_resumo(75, 25, 99);
+
+    // Média da janela (o balde aberto de 10 s tem 90..99)
+    PontoTendencia p = tendencia_resumo(&tendencia, 0, 10);
+    VERIFICAR(q16_comparar(p.media, Q16_CONST(94.5)) == 0, "media de 10 s %.3f", q16_para_float(p.media));
+    // Baldes de níveis diferentes pesam pelos segundos que cobrem: 85..99 e 39..99
+    p = tendencia_resumo(&tendencia, 0, 15);
+    VERIFICAR(q16_comparar(p.media, Q16_INT(92)) == 0, "media de 15 s %.3f", q16_para_float(p.media));
+    p = tendencia_resumo(&tendencia, 0, 61);
+    VERIFICAR(q16_comparar(p.media, Q16_INT(69)) == 0, "media de 61 s %.3f", q16_para_float(p.media));
+    p = tendencia_resumo(&tendencia, 1, 10);
+    VERIFICAR(q16_comparar(p.minimo, Q16_INT(1)) == 0 && q16_comparar(p.maximo, Q16_INT(10)) == 0,
+              "canal 1, janela 10 s: %.2f-%.2f", q16_para_float(p.minimo), q16_para_float(p.maximo));
+
+    // Janela que excede o histórico: todo o histórico
+    verificar_resumo(30 * 60, 0, 99);
+
+    // Série de 10 pontos nos últimos 100 s: um ponto por 10 s fechados
+    PontoTendencia serie[10];
+    uint32_t validos = tendencia_serie(&tendencia, 0, 100, serie, 10);
+    VERIFICAR(validos == 9, "%u pontos validos na serie", validos);
+    return RESULTADO_TESTE();
+}
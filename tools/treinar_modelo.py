@@ -0,0 +1,317 @@
+#!/usr/bin/env python3
+"""Treina o classificador do estado cognitivo e exporta include/modelo_cognitivo_dados.h.
+
+Lê os vetores de características gravados pela serial (linhas "VETOR,...",
+ligadas com o comando 'V'), treina um conjunto de árvores de decisão (CART,
+Gini) sobre as características já quantizadas em int16, exatamente como o
+dispositivo as vê, e escreve o cabeçalho com os nós em flash.
+
+Formato de cada linha:
+    VETOR,<instante ms>,<atencao>,<relaxamento>,<delta>,<theta>,<alpha>,<beta>,
+          <theta/beta>,<engajamento>,<estado das regras>,<rotulo>
+O rótulo (0-5, definido pelos dígitos na serial) tem precedência; -1 usa o
+estado da tabela de regiões. Sem gravações, --sintetico N gera vetores a
+partir do mesmo modelo de bandas do gerador de EEG sintético, rotulados pela
+tabela de regiões com os limiares padrão. Um modelo só com vetores
+sintéticos apenas imita a tabela de regiões, então sai com
+MODELO_COGNITIVO_DISPONIVEL 0 e o dispositivo segue pelas regras.
+
+Só usa a biblioteca padrão.
+"""
+
+import argparse
+import math
+import os
+import random
+import sys
+
+CARACTERISTICAS = [
+    "CARAC_ATENCAO", "CARAC_RELAXAMENTO", "CARAC_DELTA", "CARAC_THETA",
+    "CARAC_ALPHA", "CARAC_BETA", "CARAC_THETA_BETA", "CARAC_ENGAJAMENTO",
+]
+ESTADOS = ["Distraido", "Normal", "Concentrado", "Relaxado", "Flow", "Ansioso"]
+NUM_CARAC = len(CARACTERISTICAS)
+NUM_ESTADOS = len(ESTADOS)
+
+SAIDA_PADRAO = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                            "..", "include", "modelo_cognitivo_dados.h")
+
+
+# ---------------------------------------------------------------------------
+# Dados
+# ---------------------------------------------------------------------------
+
+def ler_gravacoes(caminhos, somente_rotulados):
+    vetores, rotulos = [], []
+    for caminho in caminhos:
+        with open(caminho, encoding="utf-8", errors="replace") as arquivo:
+            for linha in arquivo:
+                inicio = linha.find("VETOR,")
+                if inicio < 0:
+                    continue
+                campos = linha[inicio:].strip().split(",")
+                if len(campos) != 2 + NUM_CARAC + 2:
+                    continue
+                try:
+                    valores = [float(c) for c in campos[2:2 + NUM_CARAC]]
+                    regras = int(campos[2 + NUM_CARAC])
+                    rotulo = int(campos[3 + NUM_CARAC])
+                except ValueError:
+                    continue
+                if rotulo < 0:
+                    if somente_rotulados:
+                        continue
+                    rotulo = regras
+                if 0 <= rotulo < NUM_ESTADOS:
+                    vetores.append(valores)
+                    rotulos.append(rotulo)
+    return vetores, rotulos
+
+
+def estado_regras(atencao, relaxamento, limiares=(30, 70, 3, 7)):
+    """Tabela de regiões de classificador.c, sem histerese."""
+    at_baixo, at_alto, rx_baixo, rx_alto = limiares
+    zona_at = 0 if atencao < at_baixo else (1 if atencao < at_alto else 2)
+    zona_rx = 0 if relaxamento < rx_baixo else (1 if relaxamento < rx_alto else 2)
+    regioes = [[0, 0, 0], [1, 1, 3], [5, 2, 4]]
+    return regioes[zona_at][zona_rx]
+
+
+def gerar_sinteticos(n, rng):
+    """Bandas do gerador de EEG sintético (atualizar_gerador_eeg) com ruído."""
+    vetores, rotulos = [], []
+    for _ in range(n):
+        atencao = rng.uniform(0, 100)
+        relaxamento = rng.uniform(0, 10)
+        amplitudes = [
+            20 - 0.09 * atencao - 0.9 * relaxamento,    # delta
+            20 - 0.15 * atencao,                        # theta
+            5 + relaxamento,                            # alpha
+            10 + atencao / 5,                           # beta
+        ]
+        potencias = [max(a, 0.5) ** 2 * rng.lognormvariate(0, 0.25) + 4.0 for a in amplitudes]
+        total = sum(potencias)
+        delta, theta, alpha, beta = (100 * p / total for p in potencias)
+        vetores.append([
+            atencao + rng.gauss(0, 1.0),
+            relaxamento + rng.gauss(0, 0.125),
+            delta, theta, alpha, beta,
+            theta / beta,
+            beta / (alpha + theta),
+        ])
+        rotulos.append(estado_regras(atencao, relaxamento))
+    return vetores, rotulos
+
+
+# ---------------------------------------------------------------------------
+# Quantização (igual a quantizar() em modelo_cognitivo.c)
+# ---------------------------------------------------------------------------
+
+def escolher_deslocamentos(vetores):
+    """Menor deslocamento que mantém o dobro do maior valor visto em int16."""
+    deslocamentos = []
+    for i in range(NUM_CARAC):
+        maximo = max(abs(v[i]) for v in vetores) * 2 or 1.0
+        d = 0
+        while maximo * 65536 / (1 << d) > 32767 and d < 24:
+            d += 1
+        deslocamentos.append(d)
+    return deslocamentos
+
+
+def quantizar(vetor, deslocamentos):
+    saida = []
+    for valor, d in zip(vetor, deslocamentos):
+        q16 = int(math.floor(valor * 65536 + 0.5))
+        saida.append(max(-32768, min(32767, q16 >> d)))
+    return saida
+
+
+# ---------------------------------------------------------------------------
+# Árvores
+# ---------------------------------------------------------------------------
+
+def gini(contagens, total):
+    return 1.0 - sum((c / total) ** 2 for c in contagens) if total else 0.0
+
+
+def melhor_divisao(x, y, indices, folha_min):
+    total = len(indices)
+    contagens_pai = [0] * NUM_ESTADOS
+    for i in indices:
+        contagens_pai[y[i]] += 1
+    melhor = None
+    melhor_impureza = gini(contagens_pai, total)
+    for f in range(NUM_CARAC):
+        ordenados = sorted(indices, key=lambda i: x[i][f])
+        esquerda = [0] * NUM_ESTADOS
+        direita = list(contagens_pai)
+        for k in range(total - 1):
+            classe = y[ordenados[k]]
+            esquerda[classe] += 1
+            direita[classe] -= 1
+            atual, proximo = x[ordenados[k]][f], x[ordenados[k + 1]][f]
+            if atual == proximo or k + 1 < folha_min or total - k - 1 < folha_min:
+                continue
+            impureza = ((k + 1) * gini(esquerda, k + 1) +
+                        (total - k - 1) * gini(direita, total - k - 1)) / total
+            if impureza < melhor_impureza - 1e-12:
+                melhor_impureza = impureza
+                melhor = (f, (atual + proximo) // 2)
+    return melhor
+
+
+def construir(x, y, indices, profundidade, folha_min, nos):
+    """Acrescenta a subárvore em pré-ordem a nos; retorna o índice da raiz."""
+    contagens = [0] * NUM_ESTADOS
+    for i in indices:
+        contagens[y[i]] += 1
+    classe = max(range(NUM_ESTADOS), key=lambda c: contagens[c])
+    puro = contagens[classe] == len(indices)
+
+    divisao = None
+    if profundidade > 0 and not puro and len(indices) >= 2 * folha_min:
+        divisao = melhor_divisao(x, y, indices, folha_min)
+
+    indice = len(nos)
+    if divisao is None:
+        confianca = round(255 * contagens[classe] / len(indices))
+        nos.append({"caracteristica": -1, "classe": classe, "confianca": confianca,
+                    "limiar": 0, "direita": 0})
+        return indice
+
+    f, limiar = divisao
+    no = {"caracteristica": f, "classe": 0, "confianca": 0, "limiar": limiar, "direita": 0}
+    nos.append(no)
+    esquerda = [i for i in indices if x[i][f] <= limiar]
+    direita = [i for i in indices if x[i][f] > limiar]
+    construir(x, y, esquerda, profundidade - 1, folha_min, nos)
+    no["direita"] = construir(x, y, direita, profundidade - 1, folha_min, nos)
+    return indice
+
+
+def classificar(nos, raizes, vetor, confianca_min):
+    """Mesmo algoritmo de modelo_classificar(); None = volta às regras."""
+    votos = [0] * NUM_ESTADOS
+    for raiz in raizes:
+        no = raiz
+        while nos[no]["caracteristica"] >= 0:
+            n = nos[no]
+            no = no + 1 if vetor[n["caracteristica"]] <= n["limiar"] else n["direita"]
+        votos[nos[no]["classe"]] += nos[no]["confianca"]
+    melhor = max(range(NUM_ESTADOS), key=lambda c: (votos[c], -c))
+    media = votos[melhor] // len(raizes)
+    return melhor if media >= confianca_min else None
+
+
+# ---------------------------------------------------------------------------
+# Exportação
+# ---------------------------------------------------------------------------
+
+def escrever_cabecalho(caminho, deslocamentos, raizes, nos, confianca_min, disponivel, resumo):
+    linhas = [
+        "#ifndef MODELO_COGNITIVO_DADOS_H",
+        "#define MODELO_COGNITIVO_DADOS_H",
+        "",
+        "// Gerado por tools/treinar_modelo.py; não editar à mão.",
+    ]
+    linhas += ["// " + r for r in resumo]
+    linhas += [
+        "",
+        "#include \"modelo_cognitivo.h\"",
+        "",
+        "#define MODELO_COGNITIVO_DISPONIVEL %d" % (1 if disponivel else 0),
+        "#define MODELO_NUM_ARVORES %d" % len(raizes),
+        "#define MODELO_NUM_NOS %d" % len(nos),
+        "#define MODELO_CONFIANCA_MIN %d" % confianca_min,
+        "",
+        "// Característica em int16 = Q16.16 >> deslocamento",
+        "static const uint8_t modelo_deslocamentos[MODELO_NUM_CARACTERISTICAS] = {",
+    ]
+    for nome, d in zip(CARACTERISTICAS, deslocamentos):
+        linhas.append("    [%s] = %d," % (nome, d))
+    linhas += [
+        "};",
+        "",
+        "static const uint16_t modelo_raizes[MODELO_NUM_ARVORES] = {%s};"
+        % ", ".join(str(r) for r in raizes),
+        "",
+        "static const NoArvore modelo_nos[MODELO_NUM_NOS] = {",
+    ]
+    for i, n in enumerate(nos):
+        if n["caracteristica"] < 0:
+            linhas.append("    {-1, %d, %d, 0, 0, 0},%s// %d: %s"
+                          % (n["classe"], n["confianca"], " " * 10, i, ESTADOS[n["classe"]]))
+        else:
+            linhas.append("    {%d, 0, 0, 0, %d, %d},%s// %d: %s"
+                          % (n["caracteristica"], n["limiar"], n["direita"], " " * 4, i,
+                             CARACTERISTICAS[n["caracteristica"]]))
+    linhas += ["};", "", "#endif", ""]
+    with open(caminho, "w", encoding="utf-8") as arquivo:
+        arquivo.write("\n".join(linhas))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("gravacoes", nargs="*", help="logs da serial com linhas VETOR")
+    parser.add_argument("--sintetico", type=int, default=0, metavar="N",
+                        help="acrescenta N vetores sintéticos rotulados pelas regras")
+    parser.add_argument("--somente-rotulados", action="store_true",
+                        help="ignora vetores sem rótulo manual")
+    parser.add_argument("--arvores", type=int, default=1, help="árvores no conjunto (bagging)")
+    parser.add_argument("--profundidade", type=int, default=6, help="profundidade máxima")
+    parser.add_argument("--folha-min", type=int, default=10, help="amostras mínimas por folha")
+    parser.add_argument("--confianca-min", type=int, default=128,
+                        help="confiança média mínima (0-255) para não voltar às regras")
+    parser.add_argument("--validacao", type=float, default=0.2, help="fração para validação")
+    parser.add_argument("--semente", type=int, default=1, help="semente do sorteio")
+    parser.add_argument("-o", "--saida", default=SAIDA_PADRAO, help="cabeçalho gerado")
+    args = parser.parse_args()
+
+    rng = random.Random(args.semente)
+    vetores, rotulos = ler_gravacoes(args.gravacoes, args.somente_rotulados)
+    gravados = len(vetores)
+    if args.sintetico:
+        v, r = gerar_sinteticos(args.sintetico, rng)
+        vetores += v
+        rotulos += r
+    if len(vetores) < 2 * args.folha_min:
+        sys.exit("Vetores insuficientes: %d" % len(vetores))
+
+    deslocamentos = escolher_deslocamentos(vetores)
+    x = [quantizar(v, deslocamentos) for v in vetores]
+
+    indices = list(range(len(x)))
+    rng.shuffle(indices)
+    num_validacao = int(len(indices) * args.validacao)
+    validacao, treino = indices[:num_validacao], indices[num_validacao:]
+
+    nos, raizes = [], []
+    for _ in range(args.arvores):
+        amostra = treino if args.arvores == 1 else [rng.choice(treino) for _ in treino]
+        raizes.append(construir(x, rotulos, amostra, args.profundidade, args.folha_min, nos))
+
+    acertos = recusas = 0
+    for i in validacao:
+        previsto = classificar(nos, raizes, x[i], args.confianca_min)
+        if previsto is None:
+            recusas += 1
+        elif previsto == rotulos[i]:
+            acertos += 1
+    aceitos = len(validacao) - recusas
+    resumo = [
+        "%d vetores gravados + %d sintéticos; %d árvore(s), profundidade <= %d, %d nós"
+        % (gravados, len(vetores) - gravados, len(raizes), args.profundidade, len(nos)),
+        "Validação (%d vetores): %.1f%% de acerto nos aceitos, %.1f%% devolvidos às regras"
+        % (len(validacao), 100.0 * acertos / max(aceitos, 1), 100.0 * recusas / max(len(validacao), 1)),
+    ]
+    if not gravados:
+        resumo.append("Sem vetores gravados: só imita a tabela de regiões, exportado desligado")
+    escrever_cabecalho(args.saida, deslocamentos, raizes, nos, args.confianca_min, gravados > 0, resumo)
+    for linha in resumo:
+        print(linha)
+    print("Escrito em", os.path.normpath(args.saida))
+
+
+if __name__ == "__main__":
+    main()